@@ -1,7 +1,34 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#define TAM_PADRAO 10
+#include <stdint.h>
+#include <time.h>
+#include <sys/resource.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+#define TAM_PADRAO 10 // Alunos de exemplo criados ao iniciar
+#define CARGA_MAXIMA_INDICE 0.85 // Fração ocupada da tabela a partir da qual ela dobra de tamanho
+#define LIMITE_INSERCAO 32       // Grupos menores que isso são ordenados por inserção no radix
+#define MINIMO_POR_THREAD 65536  // Abaixo disso por thread, a ordenação roda em uma thread só
+#define ARQUIVO_BANCO "alunos.db"
+#define TAMANHO_CABECALHO_BANCO 4096 // Os alunos começam na segunda página do arquivo
+#define MINIMO_LOG 1024          // O log é compactado com pelo menos isso de operações...
+#define FRACAO_LOG 8             // ...e mais que 1/FRACAO_LOG da quantidade de alunos
+#define LOG_INSERIR 1
+#define LOG_EXCLUIR 2
+#define LIMITE_CONJUNTO_SIMD 16  // Conjuntos de matrículas até esse tamanho são comparados direto no SIMD
+#define LIMITE_MAPA_DE_BITS (1 << 26) // Maior intervalo de matrículas coberto por um mapa de bits
+
+// Campos pelos quais a turma pode ser ordenada
+#define CAMPO_NOME 0
+#define CAMPO_MATRICULA 1
+#define CAMPO_DATA 2
 
 // Criando a estrutura do tipo Aluno
 typedef struct {
@@ -11,42 +38,209 @@ typedef struct {
     char data_nasc[10];
 } Aluno;
 
+// Índice de matrícula -> posição do aluno no vetor, em uma tabela hash de endereçamento aberto
+// com Robin Hood: na inserção, quem está mais longe da sua posição ideal fica com a vaga.
+// Isso deixa as distâncias parecidas, e a busca de uma matrícula ausente pode parar assim que
+// encontra uma entrada mais perto da posição ideal do que ela estaria. A exclusão puxa as entradas
+// seguintes uma vaga para trás (sem lápides), então a tabela não degrada com o tempo
+typedef struct {
+    int matricula;
+    int posicao; // Posição no vetor de alunos; -1 marca vaga livre
+} EntradaIndice;
+
+typedef struct {
+    EntradaIndice *entradas;
+    int bits;       // A tabela tem 2^bits vagas
+    int quantidade;
+    int mapeado;    // 1 se as entradas estão no arquivo mapeado (não são liberadas com free)
+} IndiceMatricula;
+
+// Turma guardada em um único vetor contíguo de alunos (antes: um malloc por aluno e um vetor
+// fixo de TAM_PADRAO ponteiros). O vetor cresce 1.5x quando enche, então inserir no fim é O(1)
+// amortizado; percorrer a turma lê a memória em sequência, sem seguir um ponteiro por aluno
+typedef struct {
+    Aluno *alunos;
+    int tamanho;
+    int capacidade;
+    int mapeada;    // 1 se os alunos estão no arquivo mapeado (crescer copia para a memória)
+} Turma;
+
+// Banco de alunos em disco. O arquivo tem um cabeçalho, os alunos com largura fixa e o índice
+// de matrículas no mesmo formato da memória, então abrir é só um mmap (MAP_PRIVATE): a turma e o
+// índice apontam direto para as páginas mapeadas e nada é lido antes de ser usado. Depois do
+// último aluno há espaço reservado (um buraco no arquivo, sem ocupar disco) para as inserções.
+// Cada inserção ou exclusão vai para o fim de um log (<arquivo>.log) com fdatasync; ao abrir, o
+// log é reaplicado sobre o arquivo. Quando o log cresce, o banco é compactado: um arquivo novo é
+// gravado ao lado e renomeado por cima do antigo, e o log recomeça. O log guarda a geração do
+// arquivo a que pertence, então um log antigo que sobreviva a uma queda é ignorado
+typedef struct {
+    char magica[8];         // "ALUNODB1"
+    uint32_t tamanhoAluno;  // sizeof(Aluno) de quem gravou
+    uint32_t bitsIndice;
+    uint64_t geracao;
+    int32_t quantidade;
+    int32_t capacidade;     // Alunos que cabem antes do índice
+    int32_t quantidadeIndice;
+    int32_t proximaMatricula;
+    uint64_t deslocamentoIndice;
+    uint64_t tamanhoArquivo;
+} CabecalhoBanco;
+
+typedef struct {
+    char magica[8];         // "ALUNOLOG"
+    uint64_t geracao;
+} CabecalhoLog;
+
+typedef struct {
+    uint32_t operacao;      // LOG_INSERIR ou LOG_EXCLUIR (só a matrícula vale)
+    uint32_t verificacao;   // FNV-1a da operação e do aluno, para descartar uma escrita incompleta
+    Aluno aluno;
+} RegistroLog;
+
+typedef struct {
+    char caminho[256];
+    char caminhoLog[260];
+    void *mapa;
+    size_t tamanhoMapa;
+    FILE *log;
+    uint64_t geracao;
+    int registrosNoLog;
+    int proximaMatricula;
+    Turma turma;
+    IndiceMatricula indice;
+} BancoAlunos;
+
+// Texto de tamanho variável guardado em sequência em uma área única; cada aluno tem o início e o
+// tamanho do seu texto (sem o '\0')
+typedef struct {
+    char *texto;
+    size_t usado, capacidade;
+    uint32_t *inicio;
+    uint8_t *tamanho;
+} ColunaTexto;
+
+// Turma em colunas (estrutura de vetores): cada campo fica em um vetor próprio. Um filtro que só
+// olha a matrícula ou a data lê 4 bytes por aluno em sequência, em vez de passar pelos 316 bytes
+// de cada Aluno, e os vetores de int são comparados 8 (AVX2) ou 4 (SSE2) de cada vez
+typedef struct {
+    int *matricula;
+    int *data;          // Data de nascimento como o inteiro aaaammdd (0 se não estiver nesse formato)
+    ColunaTexto nome, endereco;
+    int tamanho, capacidade;
+} TurmaColunar;
+
+// Par (prefixo da chave, posição do aluno) que a ordenação move no lugar do aluno inteiro.
+// O prefixo tem os primeiros 8 bytes da chave em big-endian, então comparar os inteiros é o mesmo
+// que comparar as strings; só os empates no prefixo precisam ler o registro do aluno
+typedef struct {
+    uint64_t prefixo;
+    uint32_t indice;
+} ParOrdenacao;
+
 // Protótipos das funções
-void pesquisaAluno(Aluno *alunos[], int tamanho);
-void imprimirVetor(Aluno *alunos[], int tamanho);
-void ordenarTurma(Aluno *alunos[], int tamanho);
-void excluirAluno(Aluno *alunos[], int *tamanho);
-void insereAluno(Aluno *alunos[], int *tamanho, int *matricula);
-
-int main() {
-    int tamanho = TAM_PADRAO;
-    Aluno *alunos[tamanho];
-    int matricula = 1;
-    // Alocando memória para cada aluno e inicializando os valores
-    for (int i = 0; i < tamanho; i++) {
-        alunos[i] = (Aluno *)malloc(sizeof(Aluno));
-        alunos[i]->matricula = matricula;
-        matricula++;
-        sprintf(alunos[i]->nome, "Exemplo %d", i + 1);
-        strcpy(alunos[i]->endereco, "Padrao");
-        strcpy(alunos[i]->data_nasc, "Padrao");
+void pesquisaAluno(Turma *turma, IndiceMatricula *indice);
+void imprimirVetor(Turma *turma);
+void ordenarTurma(Turma *turma, IndiceMatricula *indice, int campo);
+void excluirAluno(Turma *turma, IndiceMatricula *indice, BancoAlunos *banco);
+void insereAluno(Turma *turma, int *matricula, IndiceMatricula *indice, BancoAlunos *banco);
+void removerDaTurma(Turma *turma, IndiceMatricula *indice, int posicao);
+void criarTurma(Turma *turma, int capacidade);
+void reservarTurma(Turma *turma, int capacidade);
+Aluno *novoAluno(Turma *turma);
+void liberarTurma(Turma *turma);
+ParOrdenacao *ordenarPares(const Turma *turma, int campo, int threads);
+void aplicarOrdem(Turma *turma, ParOrdenacao *pares);
+void criarIndice(IndiceMatricula *indice, int capacidade);
+void liberarIndice(IndiceMatricula *indice);
+int indiceBuscar(IndiceMatricula *indice, int matricula);
+void indiceInserir(IndiceMatricula *indice, int matricula, int posicao);
+void indiceAtualizar(IndiceMatricula *indice, int matricula, int posicao);
+int indiceRemover(IndiceMatricula *indice, int matricula);
+int abrirBanco(BancoAlunos *banco, const char *caminho);
+void salvarBanco(BancoAlunos *banco);
+void registrarNoLog(BancoAlunos *banco, int operacao, const Aluno *aluno);
+void fecharBanco(BancoAlunos *banco);
+void benchmarkIndice(int maximo);
+void benchmarkCarga(int n);
+void benchmarkOrdenacao(int n, int threads);
+void benchmarkBanco(int n, const char *caminho);
+void criarColunas(TurmaColunar *colunas, int capacidade);
+void acrescentarNasColunas(TurmaColunar *colunas, const Aluno *aluno);
+void converterParaColunas(const Turma *turma, TurmaColunar *colunas);
+void liberarColunas(TurmaColunar *colunas);
+int filtrarNascidosEntre(const TurmaColunar *colunas, int de, int ate, int *saida);
+int filtrarMatriculas(const TurmaColunar *colunas, const int *conjunto, int k, int *saida);
+void benchmarkColunas(int n);
+
+int main(int argc, char *argv[]) {
+    // "bench [n]": latência do índice com 1M, 10M, ... até n matrículas
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+        benchmarkIndice(argc > 2 ? atoi(argv[2]) : 50000000);
+        return 0;
+    }
+    // "carga [n]": carrega n alunos de uma vez na turma e no índice
+    if (argc > 1 && strcmp(argv[1], "carga") == 0) {
+        benchmarkCarga(argc > 2 ? atoi(argv[2]) : 10000000);
+        return 0;
+    }
+    // "ordena [n] [threads]": ordena n alunos gerados por nome, matrícula e data de nascimento
+    if (argc > 1 && strcmp(argv[1], "ordena") == 0) {
+        benchmarkOrdenacao(argc > 2 ? atoi(argv[2]) : 10000000, argc > 3 ? atoi(argv[3]) : (int)sysconf(_SC_NPROCESSORS_ONLN));
+        return 0;
+    }
+    // "banco [n] [arquivo]": grava n alunos em um banco, reabre e mede busca, log e compactação
+    if (argc > 1 && strcmp(argv[1], "banco") == 0) {
+        benchmarkBanco(argc > 2 ? atoi(argv[2]) : 1000000, argc > 3 ? argv[3] : "alunos_bench.db");
+        return 0;
+    }
+    // "colunas [n]": filtros por data e por matrícula nas colunas contra as linhas
+    if (argc > 1 && strcmp(argv[1], "colunas") == 0) {
+        benchmarkColunas(argc > 2 ? atoi(argv[2]) : 10000000);
+        return 0;
     }
 
+    BancoAlunos banco;
+    if (!abrirBanco(&banco, ARQUIVO_BANCO)) {
+        // Primeira execução: cria o banco com TAM_PADRAO alunos de exemplo
+        for (int i = 0; i < TAM_PADRAO; i++) {
+            Aluno *aluno = novoAluno(&banco.turma);
+            memset(aluno, 0, sizeof(Aluno));
+            aluno->matricula = banco.proximaMatricula;
+            banco.proximaMatricula++;
+            sprintf(aluno->nome, "Exemplo %d", i + 1);
+            strcpy(aluno->endereco, "Padrao");
+            strcpy(aluno->data_nasc, "20000101");
+            indiceInserir(&banco.indice, aluno->matricula, i);
+        }
+        salvarBanco(&banco);
+    }
+    Turma *turma = &banco.turma;
+    IndiceMatricula *indice = &banco.indice;
+
     // Chamando as funções
     int opcao = -1;
     while(opcao!=0){
-        printf("\nMenu do Sistema\n1 - Buscar por matricula\n2 - Ordenar por nome\n3 - Excluir aluno\n4 - Imprimir lista de alunos\n5  -Inserir novo aluno\n0 - Sair\nDigite a opcao desejada:");
+        printf("\nMenu do Sistema\n1 - Buscar por matricula\n2 - Ordenar turma\n3 - Excluir aluno\n4 - Imprimir lista de alunos\n5  -Inserir novo aluno\n0 - Sair\nDigite a opcao desejada:");
         scanf("%d",&opcao);
         switch(opcao){
-        case 1: pesquisaAluno(alunos,tamanho); break;
-        case 2: ordenarTurma(alunos,tamanho); break;
-        case 3: excluirAluno(alunos,&tamanho); break;
-        case 4: imprimirVetor(alunos,tamanho); break;
-        case 5: insereAluno(alunos,&tamanho,&matricula); break;
-        case 0:  // Liberando a memória alocada
-        for (int i = 0; i < tamanho; i++) {
-        free(alunos[i]);
-        }printf("Sistema finalizado com sucesso!\n"); 
+        case 1: pesquisaAluno(turma,indice); break;
+        case 2: {
+            int campo;
+            printf("Ordenar por (0) nome, (1) matricula ou (2) data de nascimento: ");
+            scanf("%d", &campo);
+            if (campo >= CAMPO_NOME && campo <= CAMPO_DATA) {
+                ordenarTurma(turma,indice,campo);
+            } else {
+                printf("Campo invalido!\n");
+            }
+            break;
+        }
+        case 3: excluirAluno(turma,indice,&banco); break;
+        case 4: imprimirVetor(turma); break;
+        case 5: insereAluno(turma,&banco.proximaMatricula,indice,&banco); break;
+        case 0:  // Fechando o banco (as alterações já estão no log) e liberando a memória
+        fecharBanco(&banco);
+        printf("Sistema finalizado com sucesso!\n"); 
         break;
         default: printf("Opção invalida! Tente novamente.\n"); break;
     }
@@ -54,83 +248,1589 @@ int main() {
     return 0;
 }
 
-void imprimirVetor(Aluno *alunos[], int tamanho) {
-    for (int j = 0; j < tamanho; j++) {
-        printf("%i - %s\n", alunos[j]->matricula, alunos[j]->nome);
+void imprimirVetor(Turma *turma) {
+    for (int j = 0; j < turma->tamanho; j++) {
+        printf("%i - %s\n", turma->alunos[j].matricula, turma->alunos[j].nome);
     }
 }
 
-void pesquisaAluno(Aluno *alunos[], int tamanho) {
-    int matr, ind = -1;
+void pesquisaAluno(Turma *turma, IndiceMatricula *indice) {
+    int matr, ind;
     printf("Digite a matricula: ");
     scanf("%d", &matr);
-    for (int j = 0; j < tamanho; j++) {
-        if (alunos[j]->matricula == matr) {
-            ind = j;
-            break;
-        }
-    }
-    if (ind >= 0) {
-        printf("O aluno %s, matricula %d foi encontrado!\n\n", alunos[ind]->nome, alunos[ind]->matricula);
+    ind = indiceBuscar(indice, matr); // O(1) em vez de percorrer o vetor
+    if (ind >= 0 && ind < turma->tamanho) {
+        printf("O aluno %s, matricula %d foi encontrado!\n\n", turma->alunos[ind].nome, turma->alunos[ind].matricula);
     } else {
         printf("Aluno nao encontrado!\n\n");
     }
 }
 
-void ordenarTurma(Aluno *alunos[], int tamanho) {
-    Aluno *temp;
-    for (int i = 0; i < tamanho - 1; i++) {
-        for (int j = 0; j < tamanho - i - 1; j++) {
-            if (strcmp(alunos[j]->nome, alunos[j + 1]->nome) > 0) {
-                // Troca as strings de posição
-                temp = alunos[j];
-                alunos[j] = alunos[j+1];
-                alunos[j+1] = temp;
-            }
-        }
+void ordenarTurma(Turma *turma, IndiceMatricula *indice, int campo) {
+    // Ordena os pares (prefixo, posição) e depois move cada aluno uma vez para o lugar final
+    ParOrdenacao *pares = ordenarPares(turma, campo, (int)sysconf(_SC_NPROCESSORS_ONLN));
+    aplicarOrdem(turma, pares);
+    free(pares);
+    // Os alunos mudaram de posição: atualiza o índice
+    for (int i = 0; i < turma->tamanho; i++) {
+        indiceAtualizar(indice, turma->alunos[i].matricula, i);
     }
     printf("\nVetor ordenado:\n");
-    imprimirVetor(alunos, tamanho);
+    imprimirVetor(turma);
 }
 
-void excluirAluno(Aluno *alunos[], int *tamanho) {
-    int matr, ind = -1;
+void excluirAluno(Turma *turma, IndiceMatricula *indice, BancoAlunos *banco) {
+    int matr, ind;
     printf("Digite a matricula do aluno a ser excluido: ");
     scanf("%d", &matr);
-    for (int j = 0; j < *tamanho; j++) {
-        if (alunos[j]->matricula == matr) {
-            ind = j;
-            break;
-        }
-    }
+    ind = indiceRemover(indice, matr);
     if (ind >= 0) {
-        for (int j = ind; j < *tamanho - 1; j++) {
-            alunos[j] = alunos[j + 1];
+        removerDaTurma(turma, indice, ind);
+        if (banco != NULL) {
+            Aluno excluido;
+            memset(&excluido, 0, sizeof(Aluno));
+            excluido.matricula = matr;
+            registrarNoLog(banco, LOG_EXCLUIR, &excluido);
         }
-        (*tamanho)--;
         printf("Aluno com matricula %d excluido.\n\n", matr);
     } else {
         printf("Aluno nao encontrado!\n\n");
     }
 }
 
-void insereAluno(Aluno *alunos[], int *tamanho, int *matricula) {
-    
-    if (*tamanho >= TAM_PADRAO) {
-        printf("Nao e possivel adicionar mais alunos, limite maximo atingido.\n");
-        return;
-    }  
-    if(*tamanho < TAM_PADRAO){ // Ou um else... está if para melhor compreensão
-    *alunos = realloc(*alunos, (*tamanho + 1) * sizeof(Aluno *));
-    Aluno *novoaluno = (Aluno *)malloc(sizeof(Aluno));
-    novoaluno->matricula = *matricula;
+// Tira da turma o aluno da posição (já removido do índice)
+void removerDaTurma(Turma *turma, IndiceMatricula *indice, int posicao) {
+    // O último aluno ocupa a posição do excluído, sem deslocar o resto do vetor
+    turma->tamanho--;
+    if (posicao != turma->tamanho) {
+        turma->alunos[posicao] = turma->alunos[turma->tamanho];
+        indiceAtualizar(indice, turma->alunos[posicao].matricula, posicao);
+    }
+}
+
+// Se dia/mes/ano é uma data que existe
+int dataValida(int ano, int mes, int dia) {
+    int diasNoMes[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    if (ano < 1 || mes < 1 || mes > 12 || dia < 1) {
+        return 0;
+    }
+    int bissexto = (ano % 4 == 0 && ano % 100 != 0) || ano % 400 == 0;
+    return dia <= diasNoMes[mes - 1] + (mes == 2 && bissexto);
+}
+
+// Lê os quantidade dígitos do início de texto como número (-1 se algum não for dígito)
+int lerDigitos(const char *texto, int quantidade) {
+    int numero = 0;
+    for (int i = 0; i < quantidade; i++) {
+        if (texto[i] < '0' || texto[i] > '9') {
+            return -1;
+        }
+        numero = numero * 10 + (texto[i] - '0');
+    }
+    return numero;
+}
+
+// Lê uma data digitada como "aaaammdd" ou "dd/mm/aaaa" e escreve em data_nasc no formato "aaaammdd",
+// que é o guardado na turma (assim a ordem das strings é a ordem das datas). Retorna 0 se a data não vale
+int normalizarData(const char *lida, char *data_nasc) {
+    int ano, mes, dia;
+    size_t tamanho = strlen(lida);
+    if (tamanho == 8) {
+        ano = lerDigitos(lida, 4);
+        mes = lerDigitos(lida + 4, 2);
+        dia = lerDigitos(lida + 6, 2);
+    } else if (tamanho == 10 && lida[2] == '/' && lida[5] == '/') {
+        dia = lerDigitos(lida, 2);
+        mes = lerDigitos(lida + 3, 2);
+        ano = lerDigitos(lida + 6, 4);
+    } else {
+        return 0;
+    }
+    if (!dataValida(ano, mes, dia)) {
+        return 0;
+    }
+    sprintf(data_nasc, "%04d%02d%02d", ano, mes, dia);
+    return 1;
+}
+
+void insereAluno(Turma *turma, int *matricula, IndiceMatricula *indice, BancoAlunos *banco) {
+    // Lê para uma variável local: novoAluno pode mover o vetor da turma
+    Aluno lido;
+    memset(&lido, 0, sizeof(Aluno)); // O aluno vai inteiro para o disco
+    lido.matricula = *matricula;
     printf("- Inserindo novo aluno -\nDigite o nome do novo aluno: ");
-    scanf("%s", novoaluno->nome);
+    scanf("%99s", lido.nome);
     printf("- Digite o endereco do novo aluno: ");
-    scanf("%s", novoaluno->endereco);
-    printf("- Digite a data de nascimento do novo aluno: ");
-    scanf("%s", novoaluno->data_nasc);
-    alunos[*tamanho] = novoaluno;
-    (*tamanho)++;
-    (*matricula)++;}
+    scanf("%199s", lido.endereco);
+    printf("- Digite a data de nascimento do novo aluno (aaaammdd ou dd/mm/aaaa): ");
+    char data[16];
+    while (1) {
+        if (scanf("%15s", data) != 1) {
+            printf("Erro: Falha ao ler a data de nascimento.\n");
+            exit(-1);
+        }
+        if (normalizarData(data, lido.data_nasc)) {
+            break;
+        }
+        printf("- Data invalida, digite novamente (aaaammdd ou dd/mm/aaaa): ");
+    }
+    *novoAluno(turma) = lido;
+    indiceInserir(indice, lido.matricula, turma->tamanho - 1);
+    (*matricula)++;
+    if (banco != NULL) {
+        registrarNoLog(banco, LOG_INSERIR, &lido);
+    }
+}
+
+// Cria uma turma vazia com espaço para capacidade alunos
+void criarTurma(Turma *turma, int capacidade) {
+    turma->alunos = NULL;
+    turma->tamanho = 0;
+    turma->capacidade = 0;
+    turma->mapeada = 0;
+    reservarTurma(turma, capacidade);
+}
+
+// Garante espaço para pelo menos capacidade alunos sem realocar
+// (útil quando a quantidade é conhecida antes, como numa carga em lote)
+void reservarTurma(Turma *turma, int capacidade) {
+    if (capacidade <= turma->capacidade) {
+        return;
+    }
+    // realloc de blocos grandes remapeia as páginas em vez de copiar os alunos
+    // (uma turma mapeada de um arquivo é copiada para a memória uma vez)
+    Aluno *novos = (Aluno *)realloc(turma->mapeada ? NULL : turma->alunos, (size_t)capacidade * sizeof(Aluno));
+    if (novos == NULL) {
+        printf("Erro: Falha ao alocar memória para a turma.\n");
+        exit(-1);
+    }
+    if (turma->mapeada) {
+        memcpy(novos, turma->alunos, (size_t)turma->tamanho * sizeof(Aluno));
+        turma->mapeada = 0;
+    }
+    turma->alunos = novos;
+    turma->capacidade = capacidade;
+}
+
+// Acrescenta um aluno no fim da turma e devolve o espaço dele para ser preenchido
+// O ponteiro vale até a próxima inserção, que pode mover o vetor
+Aluno *novoAluno(Turma *turma) {
+    if (turma->tamanho == turma->capacidade) {
+        reservarTurma(turma, turma->capacidade < 16 ? 16 : turma->capacidade + turma->capacidade / 2);
+    }
+    return &turma->alunos[turma->tamanho++];
+}
+
+void liberarTurma(Turma *turma) {
+    if (!turma->mapeada) {
+        free(turma->alunos);
+    }
+    turma->mapeada = 0;
+    turma->alunos = NULL;
+    turma->tamanho = turma->capacidade = 0;
+}
+
+// Texto do campo de ordenação e o tamanho do vetor que o guarda
+const char *textoDoCampo(const Aluno *aluno, int campo, int *tamanho) {
+    if (campo == CAMPO_NOME) {
+        *tamanho = sizeof(aluno->nome);
+        return aluno->nome;
+    }
+    *tamanho = sizeof(aluno->data_nasc);
+    return aluno->data_nasc;
+}
+
+// Prefixo de 8 bytes da chave do aluno a partir do byte profundidade (completado com zeros depois do fim)
+// A matrícula vira um inteiro sem sinal que preserva a ordem e ocupa os 4 bytes mais altos
+uint64_t prefixoDoCampo(const Aluno *aluno, int campo, int profundidade) {
+    if (campo == CAMPO_MATRICULA) {
+        return (uint64_t)((uint32_t)aluno->matricula ^ 0x80000000u) << 32;
+    }
+    int tamanho;
+    const char *texto = textoDoCampo(aluno, campo, &tamanho);
+    uint64_t prefixo = 0;
+    for (int j = 0; j < 8; j++) {
+        unsigned char c = profundidade + j < tamanho ? (unsigned char)texto[profundidade + j] : 0;
+        if (c == 0) {
+            // Completa com zeros à direita; com j == 0 a chave já acabou (deslocar 64 bits seria indefinido)
+            return j == 0 ? 0 : prefixo << (8 * (8 - j));
+        }
+        prefixo = (prefixo << 8) | c;
+    }
+    return prefixo;
+}
+
+// Se dois pares com o mesmo prefixo ainda podem ser diferentes depois dele
+int prefixoContinua(uint64_t prefixo, int campo) {
+    return campo != CAMPO_MATRICULA && (prefixo & 0xff) != 0;
+}
+
+// Compara dois pares cujos prefixos começam no byte profundidade da chave
+int compararPares(const ParOrdenacao *a, const ParOrdenacao *b, const Turma *turma, int campo, int profundidade) {
+    if (a->prefixo != b->prefixo) {
+        return a->prefixo < b->prefixo ? -1 : 1;
+    }
+    if (!prefixoContinua(a->prefixo, campo)) {
+        return 0;
+    }
+    int tamanho;
+    const char *x = textoDoCampo(&turma->alunos[a->indice], campo, &tamanho);
+    const char *y = textoDoCampo(&turma->alunos[b->indice], campo, &tamanho);
+    int inicio = profundidade + 8;
+    return inicio < tamanho ? strncmp(x + inicio, y + inicio, tamanho - inicio) : 0;
+}
+
+// Ordenação por inserção (estável) para grupos pequenos
+void ordenarInsercao(ParOrdenacao *v, size_t n, const Turma *turma, int campo, int profundidade) {
+    for (size_t i = 1; i < n; i++) {
+        ParOrdenacao atual = v[i];
+        size_t j = i;
+        while (j > 0 && compararPares(&v[j - 1], &atual, turma, campo, profundidade) > 0) {
+            v[j] = v[j - 1];
+            j--;
+        }
+        v[j] = atual;
+    }
+}
+
+// Radix sort MSD (estável) pelo byte "byte" do prefixo, usando aux como vetor temporário.
+// Quando os 8 bytes empatam e a chave continua, o grupo recarrega o prefixo com os 8 bytes
+// seguintes do registro e continua; no fim o prefixo original volta para o merge entre threads
+void ordenarRadix(ParOrdenacao *v, ParOrdenacao *aux, size_t n, int byte, const Turma *turma, int campo,
+                  int profundidade) {
+    while (1) {
+        if (n < LIMITE_INSERCAO) {
+            ordenarInsercao(v, n, turma, campo, profundidade);
+            return;
+        }
+        if (byte == 8) {
+            // Todos os pares têm o mesmo prefixo
+            uint64_t salvo = v[0].prefixo;
+            if (!prefixoContinua(salvo, campo)) {
+                return;
+            }
+            for (size_t i = 0; i < n; i++) {
+                v[i].prefixo = prefixoDoCampo(&turma->alunos[v[i].indice], campo, profundidade + 8);
+            }
+            ordenarRadix(v, aux, n, 0, turma, campo, profundidade + 8);
+            for (size_t i = 0; i < n; i++) {
+                v[i].prefixo = salvo;
+            }
+            return;
+        }
+
+        int deslocamento = 56 - 8 * byte;
+        size_t contagem[256] = {0};
+        for (size_t i = 0; i < n; i++) {
+            contagem[(v[i].prefixo >> deslocamento) & 0xff]++;
+        }
+        // Se todos caem no mesmo balde, passa direto para o próximo byte sem mover nada
+        if (contagem[(v[0].prefixo >> deslocamento) & 0xff] == n) {
+            byte++;
+            continue;
+        }
+        size_t inicio[256], soma = 0;
+        for (int c = 0; c < 256; c++) {
+            inicio[c] = soma;
+            soma += contagem[c];
+        }
+        for (size_t i = 0; i < n; i++) {
+            aux[inicio[(v[i].prefixo >> deslocamento) & 0xff]++] = v[i];
+        }
+        memcpy(v, aux, n * sizeof(ParOrdenacao));
+        soma = 0;
+        for (int c = 0; c < 256; c++) {
+            if (contagem[c] > 1) {
+                ordenarRadix(v + soma, aux + soma, contagem[c], byte + 1, turma, campo, profundidade);
+            }
+            soma += contagem[c];
+        }
+        return;
+    }
+}
+
+// Trabalho de uma thread: ordenar um bloco ou intercalar um trecho da saída
+typedef struct {
+    const Turma *turma;
+    int campo;
+    ParOrdenacao *v, *aux; // Bloco a ordenar (ordenação)
+    size_t n;
+    const ParOrdenacao *a, *b; // Sequências ordenadas a intercalar (intercalação)
+    size_t na, nb;
+    ParOrdenacao *saida;
+    size_t inicio, fim; // Trecho [inicio, fim) da saída que esta thread escreve
+} TarefaOrdenacao;
+
+void *ordenarBloco(void *arg) {
+    TarefaOrdenacao *t = (TarefaOrdenacao *)arg;
+    ordenarRadix(t->v, t->aux, t->n, 0, t->turma, t->campo, 0);
+    return NULL;
+}
+
+// Quantos elementos de a estão entre os k primeiros da intercalação estável de a com b
+// (busca binária no "merge path"; nos empates os de a vêm antes)
+size_t posicaoNaIntercalacao(const TarefaOrdenacao *t, size_t k) {
+    size_t menor = k > t->nb ? k - t->nb : 0, maior = k < t->na ? k : t->na;
+    while (menor < maior) {
+        size_t i = (menor + maior) / 2, j = k - i;
+        if (j > 0 && compararPares(&t->b[j - 1], &t->a[i], t->turma, t->campo, 0) >= 0) {
+            menor = i + 1;
+        } else {
+            maior = i;
+        }
+    }
+    return menor;
+}
+
+void *intercalarTrecho(void *arg) {
+    TarefaOrdenacao *t = (TarefaOrdenacao *)arg;
+    size_t i = posicaoNaIntercalacao(t, t->inicio), j = t->inicio - i;
+    for (size_t k = t->inicio; k < t->fim; k++) {
+        if (j >= t->nb || (i < t->na && compararPares(&t->a[i], &t->b[j], t->turma, t->campo, 0) <= 0)) {
+            t->saida[k] = t->a[i++];
+        } else {
+            t->saida[k] = t->b[j++];
+        }
+    }
+    return NULL;
+}
+
+// Intercala a e b em saida dividindo a saída em trechos iguais entre as threads
+void intercalarParalelo(const ParOrdenacao *a, size_t na, const ParOrdenacao *b, size_t nb, ParOrdenacao *saida,
+                        const Turma *turma, int campo, int threads) {
+    pthread_t ids[threads];
+    TarefaOrdenacao tarefas[threads];
+    size_t total = na + nb;
+    for (int t = 0; t < threads; t++) {
+        TarefaOrdenacao tarefa = {turma, campo, NULL, NULL, 0, a, b, na, nb, saida,
+                                  total * t / threads, total * (t + 1) / threads};
+        tarefas[t] = tarefa;
+        if (t > 0 && pthread_create(&ids[t], NULL, intercalarTrecho, &tarefas[t]) != 0) {
+            intercalarTrecho(&tarefas[t]);
+            ids[t] = 0;
+        }
+    }
+    intercalarTrecho(&tarefas[0]);
+    for (int t = 1; t < threads; t++) {
+        if (ids[t] != 0) {
+            pthread_join(ids[t], NULL);
+        }
+    }
+}
+
+// Ordena os alunos da turma pelo campo (de forma estável) e devolve os pares ordenados.
+// Cada thread ordena um bloco com o radix; depois os blocos são intercalados dois a dois,
+// com todas as threads trabalhando em cada intercalação
+ParOrdenacao *ordenarPares(const Turma *turma, int campo, int threads) {
+    size_t n = (size_t)turma->tamanho;
+    ParOrdenacao *pares = (ParOrdenacao *)malloc((n ? n : 1) * sizeof(ParOrdenacao));
+    ParOrdenacao *aux = (ParOrdenacao *)malloc((n ? n : 1) * sizeof(ParOrdenacao));
+    if (pares == NULL || aux == NULL) {
+        printf("Erro: Falha ao alocar memória para a ordenação.\n");
+        exit(-1);
+    }
+    for (size_t i = 0; i < n; i++) {
+        pares[i].prefixo = prefixoDoCampo(&turma->alunos[i], campo, 0);
+        pares[i].indice = (uint32_t)i;
+    }
+    if (threads > (int)(n / MINIMO_POR_THREAD)) {
+        threads = (int)(n / MINIMO_POR_THREAD);
+    }
+    if (threads <= 1) {
+        ordenarRadix(pares, aux, n, 0, turma, campo, 0);
+        free(aux);
+        return pares;
+    }
+
+    // Blocos [limites[b], limites[b + 1]) ordenados em paralelo
+    pthread_t ids[threads];
+    TarefaOrdenacao tarefas[threads];
+    size_t limites[threads + 1];
+    for (int t = 0; t <= threads; t++) {
+        limites[t] = n * t / threads;
+    }
+    for (int t = 0; t < threads; t++) {
+        TarefaOrdenacao tarefa = {turma, campo, pares + limites[t], aux + limites[t], limites[t + 1] - limites[t],
+                                  NULL, NULL, 0, 0, NULL, 0, 0};
+        tarefas[t] = tarefa;
+        if (pthread_create(&ids[t], NULL, ordenarBloco, &tarefas[t]) != 0) {
+            ordenarBloco(&tarefas[t]);
+            ids[t] = 0;
+        }
+    }
+    for (int t = 0; t < threads; t++) {
+        if (ids[t] != 0) {
+            pthread_join(ids[t], NULL);
+        }
+    }
+
+    // Intercala os blocos vizinhos até sobrar um só, alternando entre pares e aux
+    int blocos = threads;
+    ParOrdenacao *origem = pares, *destino = aux;
+    while (blocos > 1) {
+        int novos = 0;
+        for (int b = 0; b < blocos; b += 2) {
+            size_t inicio = limites[b], meio = limites[b + 1];
+            if (b + 1 < blocos) {
+                size_t fim = limites[b + 2];
+                intercalarParalelo(origem + inicio, meio - inicio, origem + meio, fim - meio, destino + inicio,
+                                   turma, campo, threads);
+                limites[novos + 1] = fim;
+            } else {
+                memcpy(destino + inicio, origem + inicio, (meio - inicio) * sizeof(ParOrdenacao));
+                limites[novos + 1] = meio;
+            }
+            novos++;
+        }
+        blocos = novos;
+        ParOrdenacao *temp = origem;
+        origem = destino;
+        destino = temp;
+    }
+    free(destino);
+    return origem;
+}
+
+// Coloca os alunos na ordem dos pares, seguindo os ciclos da permutação: cada aluno é copiado
+// uma vez e só um fica guardado fora do vetor. Os índices dos pares são usados como marcação
+void aplicarOrdem(Turma *turma, ParOrdenacao *pares) {
+    for (uint32_t i = 0; i < (uint32_t)turma->tamanho; i++) {
+        if (pares[i].indice == i) {
+            continue;
+        }
+        Aluno temp = turma->alunos[i];
+        uint32_t j = i;
+        while (pares[j].indice != i) {
+            uint32_t k = pares[j].indice;
+            turma->alunos[j] = turma->alunos[k];
+            pares[j].indice = j;
+            j = k;
+        }
+        turma->alunos[j] = temp;
+        pares[j].indice = j;
+    }
+}
+
+// Posição ideal da matrícula na tabela (hash de Fibonacci: multiplica e usa os bits altos)
+uint32_t posicaoIdeal(IndiceMatricula *indice, int matricula) {
+    return ((uint32_t)matricula * 2654435769u) >> (32 - indice->bits);
+}
+
+// Cria um índice vazio com espaço para pelo menos capacidade matrículas
+void criarIndice(IndiceMatricula *indice, int capacidade) {
+    indice->bits = 4;
+    while ((double)(1u << indice->bits) * CARGA_MAXIMA_INDICE < capacidade) {
+        indice->bits++;
+    }
+    indice->quantidade = 0;
+    indice->mapeado = 0;
+    indice->entradas = (EntradaIndice *)malloc(((size_t)1 << indice->bits) * sizeof(EntradaIndice));
+    if (indice->entradas == NULL) {
+        printf("Erro: Falha ao alocar memória para o índice.\n");
+        exit(-1);
+    }
+    for (size_t i = 0; i < ((size_t)1 << indice->bits); i++) {
+        indice->entradas[i].posicao = -1;
+    }
+}
+
+void liberarIndice(IndiceMatricula *indice) {
+    if (!indice->mapeado) {
+        free(indice->entradas);
+    }
+    indice->mapeado = 0;
+    indice->entradas = NULL;
+    indice->quantidade = 0;
+}
+
+// Retorna a vaga da tabela com a matrícula, ou -1 se ela não estiver no índice
+int vagaDaMatricula(IndiceMatricula *indice, int matricula) {
+    uint32_t mascara = (1u << indice->bits) - 1;
+    uint32_t vaga = posicaoIdeal(indice, matricula);
+    for (uint32_t distancia = 0;; distancia++, vaga = (vaga + 1) & mascara) {
+        EntradaIndice *e = &indice->entradas[vaga];
+        if (e->posicao < 0) {
+            return -1;
+        }
+        if (e->matricula == matricula) {
+            return (int)vaga;
+        }
+        // Robin Hood: se a matrícula estivesse na tabela, já teria tomado a vaga desta entrada
+        if (((vaga - posicaoIdeal(indice, e->matricula)) & mascara) < distancia) {
+            return -1;
+        }
+    }
+}
+
+// Retorna a posição do aluno com a matrícula, ou -1
+int indiceBuscar(IndiceMatricula *indice, int matricula) {
+    int vaga = vagaDaMatricula(indice, matricula);
+    return vaga < 0 ? -1 : indice->entradas[vaga].posicao;
+}
+
+// Coloca a entrada na tabela sem verificar a carga (a matrícula não pode estar no índice)
+void colocarEntrada(IndiceMatricula *indice, EntradaIndice nova) {
+    uint32_t mascara = (1u << indice->bits) - 1;
+    uint32_t vaga = posicaoIdeal(indice, nova.matricula);
+    uint32_t distancia = 0;
+    while (indice->entradas[vaga].posicao >= 0) {
+        EntradaIndice *e = &indice->entradas[vaga];
+        uint32_t distanciaAtual = (vaga - posicaoIdeal(indice, e->matricula)) & mascara;
+        if (distanciaAtual < distancia) {
+            // A entrada atual está mais perto da posição ideal: a nova fica com a vaga e ela continua
+            EntradaIndice temp = *e;
+            *e = nova;
+            nova = temp;
+            distancia = distanciaAtual;
+        }
+        vaga = (vaga + 1) & mascara;
+        distancia++;
+    }
+    indice->entradas[vaga] = nova;
+    indice->quantidade++;
+}
+
+// Insere a matrícula apontando para posicao (ou atualiza, se ela já estiver no índice)
+void indiceInserir(IndiceMatricula *indice, int matricula, int posicao) {
+    int vaga = vagaDaMatricula(indice, matricula);
+    if (vaga >= 0) {
+        indice->entradas[vaga].posicao = posicao;
+        return;
+    }
+    if (indice->quantidade + 1 > (double)(1u << indice->bits) * CARGA_MAXIMA_INDICE) {
+        // Dobra a tabela e reinsere todas as entradas
+        EntradaIndice *antigas = indice->entradas;
+        size_t capacidadeAntiga = (size_t)1 << indice->bits;
+        int quantidade = indice->quantidade, mapeado = indice->mapeado;
+        criarIndice(indice, (int)(capacidadeAntiga * 2 * CARGA_MAXIMA_INDICE));
+        for (size_t i = 0; i < capacidadeAntiga; i++) {
+            if (antigas[i].posicao >= 0) {
+                colocarEntrada(indice, antigas[i]);
+            }
+        }
+        indice->quantidade = quantidade;
+        if (!mapeado) {
+            free(antigas);
+        }
+    }
+    EntradaIndice nova = {matricula, posicao};
+    colocarEntrada(indice, nova);
+}
+
+// Muda a posição de uma matrícula que já está no índice
+void indiceAtualizar(IndiceMatricula *indice, int matricula, int posicao) {
+    int vaga = vagaDaMatricula(indice, matricula);
+    if (vaga >= 0) {
+        indice->entradas[vaga].posicao = posicao;
+    }
+}
+
+// Remove a matrícula do índice e retorna a posição que ela tinha (ou -1 se não estava)
+// As entradas seguintes que não estão na posição ideal voltam uma vaga (backward shift)
+int indiceRemover(IndiceMatricula *indice, int matricula) {
+    int encontrada = vagaDaMatricula(indice, matricula);
+    if (encontrada < 0) {
+        return -1;
+    }
+    uint32_t mascara = (1u << indice->bits) - 1;
+    uint32_t vaga = (uint32_t)encontrada;
+    int posicao = indice->entradas[vaga].posicao;
+    while (1) {
+        uint32_t proxima = (vaga + 1) & mascara;
+        EntradaIndice *e = &indice->entradas[proxima];
+        if (e->posicao < 0 || posicaoIdeal(indice, e->matricula) == proxima) {
+            break;
+        }
+        indice->entradas[vaga] = *e;
+        vaga = proxima;
+    }
+    indice->entradas[vaga].posicao = -1;
+    indice->quantidade--;
+    return posicao;
+}
+
+// Verificação FNV-1a de um registro do log
+uint32_t verificarRegistro(const RegistroLog *registro) {
+    uint32_t h = 2166136261u;
+    const unsigned char *bytes = (const unsigned char *)&registro->aluno;
+    h = (h ^ registro->operacao) * 16777619u;
+    for (size_t i = 0; i < sizeof(Aluno); i++) {
+        h = (h ^ bytes[i]) * 16777619u;
+    }
+    return h;
+}
+
+// Sincroniza o diretório do arquivo, para que um rename sobreviva a uma queda
+void sincronizarDiretorio(const char *caminho) {
+    char diretorio[256];
+    const char *barra = strrchr(caminho, '/');
+    if (barra == NULL) {
+        strcpy(diretorio, ".");
+    } else {
+        snprintf(diretorio, sizeof(diretorio), "%.*s", (int)(barra - caminho) + (barra == caminho), caminho);
+    }
+    int fd = open(diretorio, O_RDONLY);
+    if (fd >= 0) {
+        fsync(fd);
+        close(fd);
+    }
+}
+
+// Mapeia o arquivo do banco e aponta a turma e o índice para as páginas mapeadas
+// Retorna 0 se o arquivo não existe
+int mapearBanco(BancoAlunos *banco) {
+    int fd = open(banco->caminho, O_RDONLY);
+    if (fd < 0) {
+        return 0;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < TAMANHO_CABECALHO_BANCO) {
+        printf("Erro: Arquivo do banco %s invalido.\n", banco->caminho);
+        exit(-1);
+    }
+    // MAP_PRIVATE: as alterações ficam só na memória do processo; o disco muda pelo log e pela compactação
+    void *mapa = mmap(NULL, (size_t)info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapa == MAP_FAILED) {
+        printf("Erro: Falha ao mapear o arquivo do banco %s.\n", banco->caminho);
+        exit(-1);
+    }
+    const CabecalhoBanco *cabecalho = (const CabecalhoBanco *)mapa;
+    if (memcmp(cabecalho->magica, "ALUNODB1", 8) != 0 || cabecalho->tamanhoAluno != sizeof(Aluno) ||
+        cabecalho->tamanhoArquivo != (uint64_t)info.st_size || cabecalho->quantidade > cabecalho->capacidade ||
+        cabecalho->bitsIndice < 4 || cabecalho->bitsIndice > 31 ||
+        cabecalho->deslocamentoIndice < TAMANHO_CABECALHO_BANCO + (uint64_t)cabecalho->capacidade * sizeof(Aluno) ||
+        cabecalho->deslocamentoIndice + ((uint64_t)1 << cabecalho->bitsIndice) * sizeof(EntradaIndice) >
+            (uint64_t)info.st_size) {
+        printf("Erro: Arquivo do banco %s invalido.\n", banco->caminho);
+        exit(-1);
+    }
+    banco->mapa = mapa;
+    banco->tamanhoMapa = (size_t)info.st_size;
+    banco->geracao = cabecalho->geracao;
+    banco->proximaMatricula = cabecalho->proximaMatricula;
+    banco->turma.alunos = (Aluno *)((char *)mapa + TAMANHO_CABECALHO_BANCO);
+    banco->turma.tamanho = cabecalho->quantidade;
+    banco->turma.capacidade = cabecalho->capacidade;
+    banco->turma.mapeada = 1;
+    banco->indice.entradas = (EntradaIndice *)((char *)mapa + cabecalho->deslocamentoIndice);
+    banco->indice.bits = (int)cabecalho->bitsIndice;
+    banco->indice.quantidade = cabecalho->quantidadeIndice;
+    banco->indice.mapeado = 1;
+    return 1;
+}
+
+// Aplica uma operação do log na turma e no índice. Aplicar de novo não muda nada:
+// inserir uma matrícula que já existe substitui o aluno e excluir uma ausente é ignorado
+void aplicarRegistro(BancoAlunos *banco, const RegistroLog *registro) {
+    int matricula = registro->aluno.matricula;
+    if (registro->operacao == LOG_INSERIR) {
+        int posicao = indiceBuscar(&banco->indice, matricula);
+        if (posicao >= 0) {
+            banco->turma.alunos[posicao] = registro->aluno;
+        } else {
+            *novoAluno(&banco->turma) = registro->aluno;
+            indiceInserir(&banco->indice, matricula, banco->turma.tamanho - 1);
+        }
+        if (matricula >= banco->proximaMatricula) {
+            banco->proximaMatricula = matricula + 1;
+        }
+    } else {
+        int posicao = indiceRemover(&banco->indice, matricula);
+        if (posicao >= 0) {
+            removerDaTurma(&banco->turma, &banco->indice, posicao);
+        }
+    }
+}
+
+// Abre o log para acrescentar, começando um novo (só com o cabeçalho) se pedido
+void abrirLog(BancoAlunos *banco, int novo) {
+    banco->log = fopen(banco->caminhoLog, novo ? "wb" : "ab");
+    if (banco->log == NULL) {
+        printf("Erro: Falha ao abrir o log %s.\n", banco->caminhoLog);
+        exit(-1);
+    }
+    if (novo) {
+        CabecalhoLog cabecalho;
+        memcpy(cabecalho.magica, "ALUNOLOG", 8);
+        cabecalho.geracao = banco->geracao;
+        fwrite(&cabecalho, sizeof(CabecalhoLog), 1, banco->log);
+        fflush(banco->log);
+        fdatasync(fileno(banco->log));
+        banco->registrosNoLog = 0;
+    }
+}
+
+// Reaplica o log da geração atual e deixa ele aberto para acrescentar.
+// Um registro incompleto no fim (queda durante a escrita) é descartado
+void reaplicarLog(BancoAlunos *banco) {
+    FILE *arquivo = fopen(banco->caminhoLog, "r+b");
+    CabecalhoLog cabecalho;
+    if (arquivo == NULL || fread(&cabecalho, sizeof(CabecalhoLog), 1, arquivo) != 1 ||
+        memcmp(cabecalho.magica, "ALUNOLOG", 8) != 0 || cabecalho.geracao != banco->geracao) {
+        // Sem log, ou log de uma geração que já foi compactada no arquivo
+        if (arquivo != NULL) {
+            fclose(arquivo);
+        }
+        abrirLog(banco, 1);
+        return;
+    }
+    RegistroLog registro;
+    long valido = (long)sizeof(CabecalhoLog);
+    banco->registrosNoLog = 0;
+    while (fread(&registro, sizeof(RegistroLog), 1, arquivo) == 1 && verificarRegistro(&registro) == registro.verificacao) {
+        aplicarRegistro(banco, &registro);
+        banco->registrosNoLog++;
+        valido += (long)sizeof(RegistroLog);
+    }
+    fflush(arquivo);
+    if (ftruncate(fileno(arquivo), valido) != 0) {
+        printf("Erro: Falha ao ajustar o log %s.\n", banco->caminhoLog);
+        exit(-1);
+    }
+    fclose(arquivo);
+    abrirLog(banco, 0);
+}
+
+// Abre o banco do arquivo (mapeando-o e reaplicando o log) e retorna 1.
+// Se o arquivo não existe, retorna 0 com a turma e o índice vazios, prontos para salvarBanco
+int abrirBanco(BancoAlunos *banco, const char *caminho) {
+    memset(banco, 0, sizeof(BancoAlunos));
+    snprintf(banco->caminho, sizeof(banco->caminho), "%s", caminho);
+    snprintf(banco->caminhoLog, sizeof(banco->caminhoLog), "%s.log", banco->caminho);
+    if (!mapearBanco(banco)) {
+        banco->proximaMatricula = 1;
+        criarTurma(&banco->turma, TAM_PADRAO);
+        criarIndice(&banco->indice, TAM_PADRAO);
+        return 0;
+    }
+    reaplicarLog(banco);
+    return 1;
+}
+
+// Grava a turma e o índice em um arquivo novo da próxima geração, troca o antigo por ele
+// (rename atômico), começa um log vazio e passa a usar o arquivo novo mapeado
+void salvarBanco(BancoAlunos *banco) {
+    char temporario[270];
+    snprintf(temporario, sizeof(temporario), "%s.tmp", banco->caminho);
+    FILE *arquivo = fopen(temporario, "wb");
+    if (arquivo == NULL) {
+        printf("Erro: Falha ao criar o arquivo %s.\n", temporario);
+        exit(-1);
+    }
+    Turma *turma = &banco->turma;
+    // Folga para inserções até a próxima compactação, sem copiar a turma para a memória
+    int capacidade = turma->tamanho + turma->tamanho / 2 + MINIMO_LOG;
+    IndiceMatricula indice;
+    criarIndice(&indice, capacidade);
+    for (int i = 0; i < turma->tamanho; i++) {
+        indiceInserir(&indice, turma->alunos[i].matricula, i);
+    }
+
+    CabecalhoBanco cabecalho;
+    memset(&cabecalho, 0, sizeof(CabecalhoBanco));
+    memcpy(cabecalho.magica, "ALUNODB1", 8);
+    cabecalho.tamanhoAluno = sizeof(Aluno);
+    cabecalho.bitsIndice = (uint32_t)indice.bits;
+    cabecalho.geracao = banco->geracao + 1;
+    cabecalho.quantidade = turma->tamanho;
+    cabecalho.capacidade = capacidade;
+    cabecalho.quantidadeIndice = indice.quantidade;
+    cabecalho.proximaMatricula = banco->proximaMatricula;
+    // O índice começa na primeira página depois da área dos alunos
+    cabecalho.deslocamentoIndice = (TAMANHO_CABECALHO_BANCO + (uint64_t)capacidade * sizeof(Aluno) + 4095) / 4096 * 4096;
+    cabecalho.tamanhoArquivo = cabecalho.deslocamentoIndice + ((uint64_t)1 << indice.bits) * sizeof(EntradaIndice);
+
+    int ok = fwrite(&cabecalho, sizeof(CabecalhoBanco), 1, arquivo) == 1 &&
+             fseeko(arquivo, TAMANHO_CABECALHO_BANCO, SEEK_SET) == 0 &&
+             fwrite(turma->alunos, sizeof(Aluno), (size_t)turma->tamanho, arquivo) == (size_t)turma->tamanho &&
+             fseeko(arquivo, (off_t)cabecalho.deslocamentoIndice, SEEK_SET) == 0 &&
+             fwrite(indice.entradas, sizeof(EntradaIndice), (size_t)1 << indice.bits, arquivo) == (size_t)1 << indice.bits &&
+             fflush(arquivo) == 0 && fsync(fileno(arquivo)) == 0;
+    ok = fclose(arquivo) == 0 && ok;
+    liberarIndice(&indice);
+    if (!ok || rename(temporario, banco->caminho) != 0) {
+        printf("Erro: Falha ao gravar o banco %s.\n", banco->caminho);
+        exit(-1);
+    }
+    sincronizarDiretorio(banco->caminho);
+
+    // A partir daqui o arquivo novo vale e o log antigo é ignorado (geração anterior)
+    liberarTurma(&banco->turma);
+    liberarIndice(&banco->indice);
+    if (banco->mapa != NULL) {
+        munmap(banco->mapa, banco->tamanhoMapa);
+        banco->mapa = NULL;
+    }
+    if (banco->log != NULL) {
+        fclose(banco->log);
+    }
+    if (!mapearBanco(banco)) {
+        printf("Erro: Falha ao reabrir o banco %s.\n", banco->caminho);
+        exit(-1);
+    }
+    abrirLog(banco, 1);
+}
+
+// Acrescenta a operação (já aplicada na memória) ao log e a grava no disco antes de retornar.
+// Se o log ficou grande, compacta o banco
+void registrarNoLog(BancoAlunos *banco, int operacao, const Aluno *aluno) {
+    RegistroLog registro;
+    registro.operacao = (uint32_t)operacao;
+    registro.aluno = *aluno;
+    registro.verificacao = verificarRegistro(&registro);
+    if (fwrite(&registro, sizeof(RegistroLog), 1, banco->log) != 1 || fflush(banco->log) != 0 ||
+        fdatasync(fileno(banco->log)) != 0) {
+        printf("Erro: Falha ao gravar no log %s.\n", banco->caminhoLog);
+        exit(-1);
+    }
+    banco->registrosNoLog++;
+    if (banco->registrosNoLog >= MINIMO_LOG && banco->registrosNoLog > banco->turma.tamanho / FRACAO_LOG) {
+        salvarBanco(banco);
+    }
+}
+
+void fecharBanco(BancoAlunos *banco) {
+    if (banco->log != NULL) {
+        fclose(banco->log);
+        banco->log = NULL;
+    }
+    liberarTurma(&banco->turma);
+    liberarIndice(&banco->indice);
+    if (banco->mapa != NULL) {
+        munmap(banco->mapa, banco->tamanhoMapa);
+        banco->mapa = NULL;
+    }
+}
+
+// Converte a data de nascimento "aaaammdd" para o inteiro aaaammdd (0 se não for uma data nesse formato,
+// como nos bancos gravados antes de insereAluno validar a data)
+int dataParaInteiro(const char *data_nasc) {
+    int data = lerDigitos(data_nasc, 8);
+    if (data < 0 || data_nasc[8] != '\0' || !dataValida(data / 10000, data / 100 % 100, data % 100)) {
+        return 0;
+    }
+    return data;
+}
+
+void *realocarColuna(void *vetor, size_t bytes) {
+    void *novo = realloc(vetor, bytes ? bytes : 1);
+    if (novo == NULL) {
+        printf("Erro: Falha ao alocar memória para as colunas.\n");
+        exit(-1);
+    }
+    return novo;
+}
+
+// Garante espaço para capacidade alunos em todas as colunas
+void reservarColunas(TurmaColunar *colunas, int capacidade) {
+    if (capacidade <= colunas->capacidade) {
+        return;
+    }
+    size_t n = (size_t)capacidade;
+    colunas->matricula = (int *)realocarColuna(colunas->matricula, n * sizeof(int));
+    colunas->data = (int *)realocarColuna(colunas->data, n * sizeof(int));
+    colunas->nome.inicio = (uint32_t *)realocarColuna(colunas->nome.inicio, n * sizeof(uint32_t));
+    colunas->nome.tamanho = (uint8_t *)realocarColuna(colunas->nome.tamanho, n);
+    colunas->endereco.inicio = (uint32_t *)realocarColuna(colunas->endereco.inicio, n * sizeof(uint32_t));
+    colunas->endereco.tamanho = (uint8_t *)realocarColuna(colunas->endereco.tamanho, n);
+    colunas->capacidade = capacidade;
+}
+
+void criarColunas(TurmaColunar *colunas, int capacidade) {
+    memset(colunas, 0, sizeof(TurmaColunar));
+    reservarColunas(colunas, capacidade);
+}
+
+// Acrescenta o texto na área da coluna (que também cresce 1.5x)
+void acrescentarTexto(ColunaTexto *coluna, int posicao, const char *texto, size_t limite) {
+    size_t tamanho = strnlen(texto, limite);
+    if (coluna->usado + tamanho > UINT32_MAX) {
+        printf("Erro: Coluna de texto cheia.\n");
+        exit(-1);
+    }
+    if (coluna->usado + tamanho > coluna->capacidade) {
+        coluna->capacidade = coluna->capacidade + coluna->capacidade / 2 + tamanho + 4096;
+        coluna->texto = (char *)realocarColuna(coluna->texto, coluna->capacidade);
+    }
+    if (tamanho > 0) {
+        // Com a coluna ainda vazia, texto é NULL e o memcpy não pode receber NULL nem com 0 bytes
+        memcpy(coluna->texto + coluna->usado, texto, tamanho);
+    }
+    coluna->inicio[posicao] = (uint32_t)coluna->usado;
+    coluna->tamanho[posicao] = (uint8_t)(tamanho > 255 ? 255 : tamanho);
+    coluna->usado += tamanho;
+}
+
+void acrescentarNasColunas(TurmaColunar *colunas, const Aluno *aluno) {
+    if (colunas->tamanho == colunas->capacidade) {
+        reservarColunas(colunas, colunas->capacidade < 16 ? 16 : colunas->capacidade + colunas->capacidade / 2);
+    }
+    int i = colunas->tamanho++;
+    colunas->matricula[i] = aluno->matricula;
+    colunas->data[i] = dataParaInteiro(aluno->data_nasc);
+    acrescentarTexto(&colunas->nome, i, aluno->nome, sizeof(aluno->nome));
+    acrescentarTexto(&colunas->endereco, i, aluno->endereco, sizeof(aluno->endereco));
+}
+
+// Monta as colunas com os alunos da turma, na mesma ordem
+void converterParaColunas(const Turma *turma, TurmaColunar *colunas) {
+    criarColunas(colunas, turma->tamanho);
+    for (int i = 0; i < turma->tamanho; i++) {
+        acrescentarNasColunas(colunas, &turma->alunos[i]);
+    }
+}
+
+void liberarColunas(TurmaColunar *colunas) {
+    free(colunas->matricula);
+    free(colunas->data);
+    free(colunas->nome.texto);
+    free(colunas->nome.inicio);
+    free(colunas->nome.tamanho);
+    free(colunas->endereco.texto);
+    free(colunas->endereco.inicio);
+    free(colunas->endereco.tamanho);
+    memset(colunas, 0, sizeof(TurmaColunar));
+}
+
+// Escreve em saida as posições base + j de cada bit j ligado na máscara e retorna quantas escreveu
+static inline int escreverPosicoes(unsigned mascara, int base, int *saida) {
+    int k = 0;
+    while (mascara) {
+        saida[k++] = base + __builtin_ctz(mascara);
+        mascara &= mascara - 1;
+    }
+    return k;
+}
+
+// Operações SIMD usadas pelos filtros, com 8 (AVX2) ou 4 (SSE2) inteiros de cada vez
+#if defined(__AVX2__)
+#define LARGURA_SIMD 8
+typedef __m256i VetorSimd;
+static inline VetorSimd carregarSimd(const int *v) { return _mm256_loadu_si256((const __m256i *)v); }
+static inline VetorSimd repetirSimd(int x) { return _mm256_set1_epi32(x); }
+static inline VetorSimd zeroSimd() { return _mm256_setzero_si256(); }
+static inline VetorSimd igualSimd(VetorSimd a, VetorSimd b) { return _mm256_cmpeq_epi32(a, b); }
+static inline VetorSimd maiorSimd(VetorSimd a, VetorSimd b) { return _mm256_cmpgt_epi32(a, b); }
+static inline VetorSimd ouSimd(VetorSimd a, VetorSimd b) { return _mm256_or_si256(a, b); }
+static inline VetorSimd xorSimd(VetorSimd a, VetorSimd b) { return _mm256_xor_si256(a, b); }
+static inline VetorSimd subtrairSimd(VetorSimd a, VetorSimd b) { return _mm256_sub_epi32(a, b); }
+static inline unsigned mascaraSimd(VetorSimd v) { return (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(v)); }
+#elif defined(__SSE2__)
+#define LARGURA_SIMD 4
+typedef __m128i VetorSimd;
+static inline VetorSimd carregarSimd(const int *v) { return _mm_loadu_si128((const __m128i *)v); }
+static inline VetorSimd repetirSimd(int x) { return _mm_set1_epi32(x); }
+static inline VetorSimd zeroSimd() { return _mm_setzero_si128(); }
+static inline VetorSimd igualSimd(VetorSimd a, VetorSimd b) { return _mm_cmpeq_epi32(a, b); }
+static inline VetorSimd maiorSimd(VetorSimd a, VetorSimd b) { return _mm_cmpgt_epi32(a, b); }
+static inline VetorSimd ouSimd(VetorSimd a, VetorSimd b) { return _mm_or_si128(a, b); }
+static inline VetorSimd xorSimd(VetorSimd a, VetorSimd b) { return _mm_xor_si128(a, b); }
+static inline VetorSimd subtrairSimd(VetorSimd a, VetorSimd b) { return _mm_sub_epi32(a, b); }
+static inline unsigned mascaraSimd(VetorSimd v) { return (unsigned)_mm_movemask_ps(_mm_castsi128_ps(v)); }
+#endif
+
+#ifdef LARGURA_SIMD
+// Máscara dos inteiros de v em [menor, menor + amplitude]: x está no intervalo se x - menor, sem
+// sinal, for <= amplitude. Só existe "maior que" com sinal, então os dois lados têm o bit de sinal
+// invertido antes de comparar. Não há estouro em nenhum extremo de int
+static inline unsigned mascaraNoIntervalo(VetorSimd v, int menor, uint32_t amplitude) {
+    VetorSimd sinal = repetirSimd(INT32_MIN);
+    VetorSimd deslocado = xorSimd(subtrairSimd(v, repetirSimd(menor)), sinal);
+    VetorSimd fora = maiorSimd(deslocado, repetirSimd((int)(amplitude ^ 0x80000000u)));
+    return ~mascaraSimd(fora) & ((1u << LARGURA_SIMD) - 1);
+}
+#endif
+
+// Escreve em saida as posições dos alunos com data de nascimento em [de, ate] (aaaammdd) e retorna quantos são
+int filtrarNascidosEntre(const TurmaColunar *colunas, int de, int ate, int *saida) {
+    const int *data = colunas->data;
+    int n = colunas->tamanho, k = 0, i = 0;
+    if (de > ate) {
+        return 0;
+    }
+    uint32_t amplitude = (uint32_t)ate - (uint32_t)de;
+#ifdef LARGURA_SIMD
+    for (; i + LARGURA_SIMD <= n; i += LARGURA_SIMD) {
+        k += escreverPosicoes(mascaraNoIntervalo(carregarSimd(data + i), de, amplitude), i, saida + k);
+    }
+#endif
+    for (; i < n; i++) {
+        if ((uint32_t)data[i] - (uint32_t)de <= amplitude) {
+            saida[k++] = i;
+        }
+    }
+    return k;
+}
+
+// Conjunto de matrículas preparado para os filtros:
+//   - até LIMITE_CONJUNTO_SIMD valores: comparados direto;
+//   - intervalo [menor, menor + amplitude] de até LIMITE_MAPA_DE_BITS: mapa de bits;
+//   - conjunto grande e esparso: cópia ordenada, consultada por busca binária.
+// Nos dois últimos casos o intervalo descarta antes a maioria das matrículas
+typedef struct {
+    const int *valores;
+    int k;
+    int menor;
+    uint32_t amplitude;
+    uint64_t *mapa;
+    int *ordenado;
+} ConjuntoMatriculas;
+
+int compararInteiros(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+void prepararConjunto(ConjuntoMatriculas *c, const int *conjunto, int k) {
+    memset(c, 0, sizeof(ConjuntoMatriculas));
+    c->valores = conjunto;
+    c->k = k;
+    if (k <= LIMITE_CONJUNTO_SIMD) {
+        return;
+    }
+    int menor = conjunto[0], maior = conjunto[0];
+    for (int j = 1; j < k; j++) {
+        menor = conjunto[j] < menor ? conjunto[j] : menor;
+        maior = conjunto[j] > maior ? conjunto[j] : maior;
+    }
+    c->menor = menor;
+    c->amplitude = (uint32_t)maior - (uint32_t)menor;
+    if (c->amplitude < LIMITE_MAPA_DE_BITS) {
+        c->mapa = (uint64_t *)calloc(c->amplitude / 64 + 1, sizeof(uint64_t));
+        if (c->mapa == NULL) {
+            printf("Erro: Falha ao alocar memória para o filtro.\n");
+            exit(-1);
+        }
+        for (int j = 0; j < k; j++) {
+            uint32_t bit = (uint32_t)conjunto[j] - (uint32_t)menor;
+            c->mapa[bit / 64] |= 1ull << (bit % 64);
+        }
+    } else {
+        c->ordenado = (int *)malloc((size_t)k * sizeof(int));
+        if (c->ordenado == NULL) {
+            printf("Erro: Falha ao alocar memória para o filtro.\n");
+            exit(-1);
+        }
+        memcpy(c->ordenado, conjunto, (size_t)k * sizeof(int));
+        qsort(c->ordenado, k, sizeof(int), compararInteiros);
+    }
+}
+
+void liberarConjunto(ConjuntoMatriculas *c) {
+    free(c->mapa);
+    free(c->ordenado);
+    memset(c, 0, sizeof(ConjuntoMatriculas));
+}
+
+// Se a matrícula está no conjunto
+static inline int conjuntoContem(const ConjuntoMatriculas *c, int matricula) {
+    if (c->mapa == NULL && c->ordenado == NULL) {
+        for (int j = 0; j < c->k; j++) {
+            if (c->valores[j] == matricula) {
+                return 1;
+            }
+        }
+        return 0;
+    }
+    uint32_t deslocamento = (uint32_t)matricula - (uint32_t)c->menor;
+    if (deslocamento > c->amplitude) {
+        return 0;
+    }
+    if (c->mapa != NULL) {
+        return (int)((c->mapa[deslocamento / 64] >> (deslocamento % 64)) & 1);
+    }
+    // Busca binária sem desvios: base avança enquanto o valor do meio é menor
+    const int *base = c->ordenado;
+    int restantes = c->k;
+    while (restantes > 1) {
+        int metade = restantes / 2;
+        base = base[metade] <= matricula ? base + metade : base;
+        restantes -= metade;
+    }
+    return *base == matricula;
+}
+
+// Escreve em saida as posições dos alunos cuja matrícula está no conjunto (de k matrículas) e retorna quantos são.
+// Conjuntos pequenos são comparados com cada grupo de matrículas no SIMD; nos maiores, o SIMD
+// descarta o que está fora do intervalo do conjunto e o mapa de bits ou a busca binária decide o resto
+int filtrarMatriculas(const TurmaColunar *colunas, const int *conjunto, int k, int *saida) {
+    const int *matricula = colunas->matricula;
+    int n = colunas->tamanho, total = 0, i = 0;
+    ConjuntoMatriculas c;
+    prepararConjunto(&c, conjunto, k);
+#ifdef LARGURA_SIMD
+    VetorSimd valores[LIMITE_CONJUNTO_SIMD];
+    int pequeno = k <= LIMITE_CONJUNTO_SIMD;
+    for (int j = 0; pequeno && j < k; j++) {
+        valores[j] = repetirSimd(conjunto[j]);
+    }
+    for (; i + LARGURA_SIMD <= n; i += LARGURA_SIMD) {
+        VetorSimd m = carregarSimd(matricula + i);
+        unsigned mascara;
+        if (pequeno) {
+            VetorSimd achou = zeroSimd();
+            for (int j = 0; j < k; j++) {
+                achou = ouSimd(achou, igualSimd(m, valores[j]));
+            }
+            mascara = mascaraSimd(achou);
+        } else {
+            // Candidatos dentro do intervalo: confirma cada um no conjunto
+            unsigned candidatos = mascaraNoIntervalo(m, c.menor, c.amplitude);
+            mascara = 0;
+            for (; candidatos; candidatos &= candidatos - 1) {
+                int j = __builtin_ctz(candidatos);
+                mascara |= (unsigned)conjuntoContem(&c, matricula[i + j]) << j;
+            }
+        }
+        total += escreverPosicoes(mascara, i, saida + total);
+    }
+#endif
+    for (; i < n; i++) {
+        if (conjuntoContem(&c, matricula[i])) {
+            saida[total++] = i;
+        }
+    }
+    liberarConjunto(&c);
+    return total;
+}
+
+// Retorna o tempo atual em segundos, usado no benchmark
+double tempoAtual() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Função de comparação de latências para o qsort
+int compararTempos(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Imprime a média e os percentis de uma amostra de latências (em segundos)
+void imprimirLatencias(const char *operacao, double *tempos, int n) {
+    double soma = 0;
+    for (int i = 0; i < n; i++) {
+        soma += tempos[i];
+    }
+    qsort(tempos, n, sizeof(double), compararTempos);
+    printf("  %-16s media %6.0f ns | p50 %6.0f ns | p99 %6.0f ns | p99.9 %6.0f ns | max %8.0f ns\n", operacao,
+           soma / n * 1e9, tempos[n / 2] * 1e9, tempos[(int)(n * 0.99)] * 1e9, tempos[(int)(n * 0.999)] * 1e9,
+           tempos[n - 1] * 1e9);
+}
+
+// Benchmark: latência por busca (presentes e ausentes) e por exclusão no índice,
+// com 1M, 10M, ... matrículas até maximo. Só o índice é montado (posição = i), sem os alunos
+void benchmarkIndice(int maximo) {
+    int amostras = 1000000;
+    double *tempos = (double *)malloc(amostras * sizeof(double));
+    int *ordem = (int *)malloc(amostras * sizeof(int));
+    if (tempos == NULL || ordem == NULL) {
+        printf("Erro: Falha ao alocar memória para o benchmark.\n");
+        exit(-1);
+    }
+    uint64_t estado = 88172645463325252ull;
+    int tamanhos[] = {1000000, 5000000, 10000000, 25000000, 50000000};
+    for (int t = 0; t < 5 && tamanhos[t] <= maximo; t++) {
+        int n = tamanhos[t];
+        IndiceMatricula indice;
+        criarIndice(&indice, 16);
+        double inicio = tempoAtual();
+        for (int i = 0; i < n; i++) {
+            indiceInserir(&indice, i + 1, i); // Matrículas sequenciais, como o sistema atribui
+        }
+        double tInsercao = tempoAtual() - inicio;
+        printf("%d matriculas: insercao %.1f ns/op, tabela com %d vagas (carga %.2f)\n", n, tInsercao / n * 1e9,
+               1 << indice.bits, (double)indice.quantidade / (1 << indice.bits));
+
+        // Matrículas sorteadas para as buscas e exclusões
+        for (int i = 0; i < amostras; i++) {
+            estado ^= estado << 13;
+            estado ^= estado >> 7;
+            estado ^= estado << 17;
+            ordem[i] = (int)(estado % (uint64_t)n) + 1;
+        }
+
+        long long encontradas = 0;
+        for (int i = 0; i < amostras; i++) {
+            double t0 = tempoAtual();
+            encontradas += indiceBuscar(&indice, ordem[i]) >= 0;
+            tempos[i] = tempoAtual() - t0;
+        }
+        imprimirLatencias("busca presente", tempos, amostras);
+        for (int i = 0; i < amostras; i++) {
+            double t0 = tempoAtual();
+            encontradas += indiceBuscar(&indice, n + ordem[i]) >= 0;
+            tempos[i] = tempoAtual() - t0;
+        }
+        imprimirLatencias("busca ausente", tempos, amostras);
+        int excluidas = 0;
+        for (int i = 0; i < amostras; i++) {
+            double t0 = tempoAtual();
+            excluidas += indiceRemover(&indice, ordem[i]) >= 0;
+            tempos[i] = tempoAtual() - t0;
+        }
+        imprimirLatencias("exclusao", tempos, amostras);
+        printf("  (%lld encontradas, %d excluidas, %d restantes)\n", encontradas, excluidas, indice.quantidade);
+        liberarIndice(&indice);
+    }
+    free(tempos);
+    free(ordem);
+}
+
+// Pico de memória residente do processo, em bytes
+long picoMemoria() {
+    struct rusage uso;
+    getrusage(RUSAGE_SELF, &uso);
+    return uso.ru_maxrss * 1024L;
+}
+
+// Acrescenta n alunos gerados à turma, com matrículas 1..n e data de nascimento como aaaammdd
+void gerarAlunos(Turma *turma, int n) {
+    uint32_t estado = 2463534242u;
+    for (int i = 0; i < n; i++) {
+        estado ^= estado << 13;
+        estado ^= estado >> 17;
+        estado ^= estado << 5;
+        Aluno *aluno = novoAluno(turma);
+        aluno->matricula = i + 1;
+        snprintf(aluno->nome, sizeof(aluno->nome), "Aluno %08x", estado);
+        snprintf(aluno->endereco, sizeof(aluno->endereco), "Rua %u, %u", estado % 5000, estado % 997);
+        snprintf(aluno->data_nasc, sizeof(aluno->data_nasc), "%04u%02u%02u", 1950 + estado % 60,
+                 1 + (estado >> 8) % 12, 1 + (estado >> 16) % 28);
+    }
+}
+
+// Benchmark: carrega n alunos gerados na turma (crescendo sem reserva) e no índice,
+// e compara o pico de memória com o tamanho dos registros
+void benchmarkCarga(int n) {
+    Turma turma;
+    IndiceMatricula indice;
+    criarTurma(&turma, 0);
+    criarIndice(&indice, 16);
+
+    double inicio = tempoAtual();
+    gerarAlunos(&turma, n);
+    double tTurma = tempoAtual() - inicio;
+    long picoTurma = picoMemoria();
+
+    inicio = tempoAtual();
+    for (int i = 0; i < n; i++) {
+        indiceInserir(&indice, turma.alunos[i].matricula, i);
+    }
+    double tIndice = tempoAtual() - inicio;
+
+    double registros = (double)n * sizeof(Aluno);
+    printf("%d alunos (%zu bytes cada, %.0f MiB de registros)\n", n, sizeof(Aluno), registros / 1048576);
+    printf("  turma:  %.2f s (%.0f ns/aluno), capacidade final %d, pico de memoria %.0f MiB (%.2fx os registros)\n",
+           tTurma, tTurma / n * 1e9, turma.capacidade, picoTurma / 1048576.0, picoTurma / registros);
+    printf("  indice: %.2f s (%.0f ns/aluno), %zu MiB\n", tIndice, tIndice / n * 1e9,
+           ((size_t)1 << indice.bits) * sizeof(EntradaIndice) / 1048576);
+    printf("  pico de memoria total %.0f MiB\n", picoMemoria() / 1048576.0);
+    liberarIndice(&indice);
+    liberarTurma(&turma);
+}
+
+// Comparação de ponteiros para alunos por nome, usada no qsort de referência
+int compararNomes(const void *a, const void *b) {
+    return strcmp((*(Aluno *const *)a)->nome, (*(Aluno *const *)b)->nome);
+}
+
+// Benchmark: ordena n alunos gerados por cada campo com 1 e com threads threads, confere a ordem,
+// e compara com um qsort de ponteiros que faz strcmp nos registros a cada comparação
+void benchmarkOrdenacao(int n, int threads) {
+    const char *nomesCampos[] = {"nome", "matricula", "data_nasc"};
+    Turma turma;
+    criarTurma(&turma, n);
+    gerarAlunos(&turma, n);
+    // Embaralha as matrículas para que a ordenação por matrícula tenha trabalho
+    uint32_t estado = 1u;
+    for (int i = n - 1; i > 0; i--) {
+        estado = estado * 1664525u + 1013904223u;
+        int j = (int)(estado % (uint32_t)(i + 1));
+        int temp = turma.alunos[i].matricula;
+        turma.alunos[i].matricula = turma.alunos[j].matricula;
+        turma.alunos[j].matricula = temp;
+    }
+    printf("%d alunos\n", n);
+
+    for (int campo = CAMPO_NOME; campo <= CAMPO_DATA; campo++) {
+        for (int t = 1; t <= threads; t = t == threads ? threads + 1 : (t * 2 < threads ? t * 2 : threads)) {
+            double inicio = tempoAtual();
+            ParOrdenacao *pares = ordenarPares(&turma, campo, t);
+            double tempo = tempoAtual() - inicio;
+            int ordenado = 1;
+            for (int i = 1; i < n && ordenado; i++) {
+                int c = compararPares(&pares[i - 1], &pares[i], &turma, campo, 0);
+                ordenado = c < 0 || (c == 0 && pares[i - 1].indice < pares[i].indice);
+            }
+            printf("  %-9s %2d thread(s): %.3f s (%.0f ns/aluno)%s\n", nomesCampos[campo], t, tempo, tempo / n * 1e9,
+                   ordenado ? "" : "  ERRO: fora de ordem");
+            free(pares);
+        }
+    }
+
+    // Referência: qsort de ponteiros comparando os nomes nos registros
+    Aluno **ponteiros = (Aluno **)malloc((size_t)n * sizeof(Aluno *));
+    if (ponteiros == NULL) {
+        printf("Erro: Falha ao alocar memória para o benchmark.\n");
+        exit(-1);
+    }
+    for (int i = 0; i < n; i++) {
+        ponteiros[i] = &turma.alunos[i];
+    }
+    double inicio = tempoAtual();
+    qsort(ponteiros, n, sizeof(Aluno *), compararNomes);
+    double tempo = tempoAtual() - inicio;
+    printf("  qsort de ponteiros por nome: %.3f s (%.0f ns/aluno)\n", tempo, tempo / n * 1e9);
+    free(ponteiros);
+
+    // Mover os registros para a ordem final (o que ordenarTurma faz depois dos pares)
+    ParOrdenacao *pares = ordenarPares(&turma, CAMPO_NOME, threads);
+    inicio = tempoAtual();
+    aplicarOrdem(&turma, pares);
+    tempo = tempoAtual() - inicio;
+    int ordenado = 1;
+    for (int i = 1; i < n && ordenado; i++) {
+        ordenado = strcmp(turma.alunos[i - 1].nome, turma.alunos[i].nome) <= 0;
+    }
+    printf("  aplicar a ordem nos registros: %.3f s%s\n", tempo, ordenado ? "" : "  ERRO: fora de ordem");
+    free(pares);
+    liberarTurma(&turma);
+}
+
+// Benchmark: grava n alunos gerados em um banco, tira o arquivo do cache e mede abrir (mmap),
+// buscas lendo as páginas mapeadas, o log, a reabertura com o log e a compactação.
+// Para comparar, mede também carregar os alunos com fread, como seria sem o mmap
+void benchmarkBanco(int n, const char *caminho) {
+    BancoAlunos banco;
+    unlink(caminho);
+    abrirBanco(&banco, caminho);
+    gerarAlunos(&banco.turma, n);
+    for (int i = 0; i < n; i++) {
+        indiceInserir(&banco.indice, banco.turma.alunos[i].matricula, i);
+    }
+    banco.proximaMatricula = n + 1;
+    double inicio = tempoAtual();
+    salvarBanco(&banco);
+    printf("%d alunos: gravar o arquivo %.2f s (%.0f MiB)\n", n, tempoAtual() - inicio, banco.tamanhoMapa / 1048576.0);
+    fecharBanco(&banco);
+
+    // Tira o arquivo do cache de páginas, para medir a partir do disco
+    int fd = open(caminho, O_RDONLY);
+    if (fd >= 0) {
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+    inicio = tempoAtual();
+    abrirBanco(&banco, caminho);
+    printf("  abrir (mmap + log vazio): %.1f us\n", (tempoAtual() - inicio) * 1e6);
+
+    int consultas = 100000;
+    uint32_t estado = 12345u;
+    int encontrados = 0;
+    for (int rodada = 0; rodada < 2; rodada++) {
+        inicio = tempoAtual();
+        for (int i = 0; i < consultas; i++) {
+            estado = estado * 1664525u + 1013904223u;
+            int posicao = indiceBuscar(&banco.indice, (int)(estado % (uint32_t)n) + 1);
+            encontrados += posicao >= 0 && banco.turma.alunos[posicao].matricula == (int)(estado % (uint32_t)n) + 1;
+        }
+        printf("  busca por matricula lendo o mapa (%s): %.0f ns (%d encontrados)\n",
+               rodada == 0 ? "paginas frias" : "paginas ja lidas", (tempoAtual() - inicio) / consultas * 1e9, encontrados);
+        encontrados = 0;
+    }
+
+    // Operações pelo log: metade inserções, metade exclusões, cada uma com fdatasync
+    int operacoes = 2000;
+    inicio = tempoAtual();
+    for (int i = 0; i < operacoes; i++) {
+        Aluno aluno;
+        memset(&aluno, 0, sizeof(Aluno));
+        if (i % 2 == 0) {
+            aluno.matricula = banco.proximaMatricula++;
+            snprintf(aluno.nome, sizeof(aluno.nome), "Novo %d", i);
+            *novoAluno(&banco.turma) = aluno;
+            indiceInserir(&banco.indice, aluno.matricula, banco.turma.tamanho - 1);
+            registrarNoLog(&banco, LOG_INSERIR, &aluno);
+        } else {
+            aluno.matricula = i;
+            int posicao = indiceRemover(&banco.indice, i);
+            if (posicao >= 0) {
+                removerDaTurma(&banco.turma, &banco.indice, posicao);
+            }
+            registrarNoLog(&banco, LOG_EXCLUIR, &aluno);
+        }
+    }
+    double tLog = tempoAtual() - inicio;
+    int registros = banco.registrosNoLog, tamanho = banco.turma.tamanho;
+    printf("  %d operacoes pelo log: %.1f us cada (%d registros no log)\n", operacoes, tLog / operacoes * 1e6, registros);
+    fecharBanco(&banco);
+
+    inicio = tempoAtual();
+    abrirBanco(&banco, caminho);
+    printf("  reabrir reaplicando %d registros: %.2f ms (%d alunos, %s)\n", banco.registrosNoLog,
+           (tempoAtual() - inicio) * 1e3, banco.turma.tamanho, banco.turma.tamanho == tamanho ? "ok" : "ERRO");
+    inicio = tempoAtual();
+    salvarBanco(&banco);
+    printf("  compactar: %.2f s\n", tempoAtual() - inicio);
+    fecharBanco(&banco);
+
+    // Referência: ler todos os alunos do arquivo para a memória
+    fd = open(caminho, O_RDONLY);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+    FILE *arquivo = fopen(caminho, "rb");
+    Aluno *alunos = (Aluno *)malloc((size_t)tamanho * sizeof(Aluno));
+    if (arquivo == NULL || alunos == NULL) {
+        printf("Erro: Falha ao ler o banco.\n");
+        exit(-1);
+    }
+    inicio = tempoAtual();
+    fseeko(arquivo, TAMANHO_CABECALHO_BANCO, SEEK_SET);
+    size_t lidos = fread(alunos, sizeof(Aluno), (size_t)tamanho, arquivo);
+    printf("  referencia: carregar com fread %.2f s (%zu alunos)\n", tempoAtual() - inicio, lidos);
+    fclose(arquivo);
+    free(alunos);
+    unlink(caminho);
+    unlink(banco.caminhoLog);
+}
+
+// Baseline em linhas para o benchmark: o aluno inteiro em sequência, como no vetor de Aluno, mas com a
+// data já em inteiro. Assim os dois layouts fazem a mesma comparação e só o passo entre alunos muda
+typedef struct {
+    int matricula;
+    char nome[100];
+    char endereco[200];
+    int data;
+} LinhaAluno;
+
+// Monta as linhas a partir das colunas (a turma original já foi liberada, para não ter as duas na memória)
+LinhaAluno *converterParaLinhas(const TurmaColunar *colunas) {
+    LinhaAluno *linhas = (LinhaAluno *)malloc((size_t)colunas->tamanho * sizeof(LinhaAluno));
+    if (linhas == NULL) {
+        printf("Erro: Falha ao alocar memória para o benchmark.\n");
+        exit(-1);
+    }
+    for (int i = 0; i < colunas->tamanho; i++) {
+        LinhaAluno *linha = &linhas[i];
+        size_t tamanhoNome = colunas->nome.tamanho[i] < sizeof(linha->nome) ? colunas->nome.tamanho[i] : sizeof(linha->nome) - 1;
+        size_t tamanhoEndereco = colunas->endereco.tamanho[i] < sizeof(linha->endereco) ? colunas->endereco.tamanho[i] : sizeof(linha->endereco) - 1;
+        linha->matricula = colunas->matricula[i];
+        linha->data = colunas->data[i];
+        memcpy(linha->nome, colunas->nome.texto + colunas->nome.inicio[i], tamanhoNome);
+        linha->nome[tamanhoNome] = '\0';
+        memcpy(linha->endereco, colunas->endereco.texto + colunas->endereco.inicio[i], tamanhoEndereco);
+        linha->endereco[tamanhoEndereco] = '\0';
+    }
+    return linhas;
+}
+
+// Filtros equivalentes nas linhas, para comparar com as colunas
+int filtrarNascidosEntreLinhas(const LinhaAluno *linhas, int n, int de, int ate, int *saida) {
+    int k = 0;
+    for (int i = 0; i < n; i++) {
+        if (linhas[i].data >= de && linhas[i].data <= ate) {
+            saida[k++] = i;
+        }
+    }
+    return k;
+}
+
+int filtrarMatriculasLinhas(const LinhaAluno *linhas, int n, const int *conjunto, int k, int *saida) {
+    int total = 0;
+    ConjuntoMatriculas c;
+    prepararConjunto(&c, conjunto, k);
+    for (int i = 0; i < n; i++) {
+        if (conjuntoContem(&c, linhas[i].matricula)) {
+            saida[total++] = i;
+        }
+    }
+    liberarConjunto(&c);
+    return total;
+}
+
+// Imprime o tempo de um filtro e a vazão comum aos dois layouts: alunos por segundo, GB/s úteis (os 4 bytes
+// do campo filtrado de cada aluno) e o ganho sobre as linhas (tempoLinhas). Por último, em segundo plano, os
+// GB/s que o filtro traz da memória: nas colunas são os mesmos 4 bytes por aluno; nas linhas cada aluno
+// está em outra linha de cache, então são 64 bytes por aluno mesmo que o filtro só leia um int
+void imprimirVazao(const char *filtro, const char *layout, double tempo, double tempoLinhas, int n, int bytesPorAluno,
+                   int encontrados) {
+    printf("  %-28s %-8s %8.2f ms %8.1f M alunos/s %6.2f GB/s uteis %6.2fx  (trazidos %6.2f GB/s, %d alunos)\n",
+           filtro, layout, tempo * 1e3, n / tempo / 1e6, (double)n * sizeof(int) / tempo / 1e9, tempoLinhas / tempo,
+           (double)n * bytesPorAluno / tempo / 1e9, encontrados);
+}
+
+// Benchmark: filtros "nascidos entre" e "matrícula no conjunto" nas linhas e nas colunas
+void benchmarkColunas(int n) {
+    Turma turma;
+    criarTurma(&turma, n);
+    gerarAlunos(&turma, n);
+    TurmaColunar colunas;
+    double inicio = tempoAtual();
+    converterParaColunas(&turma, &colunas);
+    double tempoConversao = tempoAtual() - inicio;
+    liberarTurma(&turma);
+    LinhaAluno *linhas = converterParaLinhas(&colunas);
+    int bytesLinha = sizeof(LinhaAluno) < 64 ? (int)sizeof(LinhaAluno) : 64;
+    printf("%d alunos: converter para colunas %.2f s; linhas %.0f MiB, colunas %.0f MiB\n", n, tempoConversao,
+           (double)n * sizeof(LinhaAluno) / 1048576,
+           ((double)n * (2 * sizeof(int) + 2 * sizeof(uint32_t) + 2) + colunas.nome.usado + colunas.endereco.usado) /
+               1048576);
+#if defined(__AVX2__)
+    printf("  SIMD: AVX2 (8 matriculas por comparacao)\n");
+#elif defined(__SSE2__)
+    printf("  SIMD: SSE2 (4 matriculas por comparacao)\n");
+#else
+    printf("  SIMD: nenhum\n");
+#endif
+
+    int *saida = (int *)malloc((size_t)n * sizeof(int));
+    int conjunto[1000];
+    if (saida == NULL) {
+        printf("Erro: Falha ao alocar memória para o benchmark.\n");
+        exit(-1);
+    }
+    uint32_t estado = 7u;
+    for (int j = 0; j < 1000; j++) {
+        estado = estado * 1664525u + 1013904223u;
+        conjunto[j] = (int)(estado % (uint32_t)n) + 1;
+    }
+
+    for (int repeticao = 0; repeticao < 2; repeticao++) {
+        // A primeira rodada só aquece as páginas
+        int mostrar = repeticao == 1;
+        double t;
+        double tLinhas;
+        int emLinhas, cols;
+
+        inicio = tempoAtual();
+        emLinhas = filtrarNascidosEntreLinhas(linhas, n, 19800101, 19891231, saida);
+        tLinhas = tempoAtual() - inicio;
+        if (mostrar) imprimirVazao("nascidos entre 1980 e 1989", "linhas", tLinhas, tLinhas, n, bytesLinha, emLinhas);
+        inicio = tempoAtual();
+        cols = filtrarNascidosEntre(&colunas, 19800101, 19891231, saida);
+        t = tempoAtual() - inicio;
+        if (mostrar) imprimirVazao("nascidos entre 1980 e 1989", "colunas", t, tLinhas, n, sizeof(int), cols);
+        if (emLinhas != cols) printf("  ERRO: filtros diferentes\n");
+
+        int tamanhos[] = {8, 1000};
+        for (int c = 0; c < 2; c++) {
+            char filtro[40];
+            snprintf(filtro, sizeof(filtro), "matricula em %d valores", tamanhos[c]);
+            inicio = tempoAtual();
+            emLinhas = filtrarMatriculasLinhas(linhas, n, conjunto, tamanhos[c], saida);
+            tLinhas = tempoAtual() - inicio;
+            if (mostrar) imprimirVazao(filtro, "linhas", tLinhas, tLinhas, n, bytesLinha, emLinhas);
+            inicio = tempoAtual();
+            cols = filtrarMatriculas(&colunas, conjunto, tamanhos[c], saida);
+            t = tempoAtual() - inicio;
+            if (mostrar) imprimirVazao(filtro, "colunas", t, tLinhas, n, sizeof(int), cols);
+            if (emLinhas != cols) printf("  ERRO: filtros diferentes\n");
+        }
+    }
+    free(saida);
+    free(linhas);
+    liberarColunas(&colunas);
 }
@@ -1,5 +1,14 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include "Arena.h"
+#include "OrdenacaoParalela.h"
+#include "BuscaEmLote.h"
+
+// Compile com -DESTATISTICA_ORDEM para guardar em cada nó o tamanho da subárvore.
+// Com ele, selecionar, posto e contarIntervalo custam O(log n) em vez de um percurso em ordem O(n)
 
 // Definição da estrutura do nó da árvore AVL
 // São utilizados três parâmetros: dado, esquerda e direita, além da altura para balanceamento
@@ -9,14 +18,21 @@ struct NoAVL
     struct NoAVL *esquerda;
     struct NoAVL *direita;
     int altura;
+#ifdef ESTATISTICA_ORDEM
+    int tamanho; // Quantidade de nós da subárvore
+#endif
 };
 
+// Tamanho máximo do caminho da raiz até uma folha
+// A altura de uma árvore AVL é no máximo ~1,44 log2(n), então 64 níveis bastam para qualquer n de 32 bits
+#define ALTURA_MAXIMA_AVL 64
+
 // Função para criar um novo nó na árvore
-// Recebe um valor inteiro como parâmetro e retorna um ponteiro para o novo nó
-struct NoAVL *criarNo(int dado)
+// Recebe um valor inteiro e a arena da árvore (NULL para usar malloc) e retorna um ponteiro para o novo nó
+struct NoAVL *criarNo(int dado, Arena *arena)
 {
     // Aloca memória para um novo nó da árvore AVL
-    struct NoAVL *novoNo = (struct NoAVL *)malloc(sizeof(struct NoAVL));
+    struct NoAVL *novoNo = (struct NoAVL *)alocarNo(arena, sizeof(struct NoAVL));
     // Verifica se a alocação de memória foi bem-sucedida
     if (novoNo == NULL)
     {
@@ -28,6 +44,9 @@ struct NoAVL *criarNo(int dado)
     novoNo->esquerda = NULL; // Inicializa o ponteiro para o filho esquerdo como nulo
     novoNo->direita = NULL;  // Inicializa o ponteiro para o filho direito como nulo
     novoNo->altura = 0;      // Inicializa a altura do nó como 0
+#ifdef ESTATISTICA_ORDEM
+    novoNo->tamanho = 1;     // A subárvore tem só o próprio nó
+#endif
     return novoNo;           // Retorna o ponteiro para o novo nó criado
 }
 
@@ -51,6 +70,24 @@ int fatorBalanceamento(struct NoAVL *no)
     // Calcula o fator de balanceamento subtraindo a altura da subárvore direita pela altura da subárvore esquerda
     return altura(no->esquerda) - altura(no->direita);
 }
+
+#ifdef ESTATISTICA_ORDEM
+// Função para obter o tamanho da subárvore (0 para nulo)
+int tamanho(struct NoAVL *no)
+{
+    if (no == NULL)
+        return 0;
+    return no->tamanho;
+}
+
+// Função para recalcular o tamanho de um nó a partir dos filhos
+void atualizarTamanho(struct NoAVL *no)
+{
+    no->tamanho = 1 + tamanho(no->esquerda) + tamanho(no->direita);
+}
+#else
+#define atualizarTamanho(no) ((void)0)
+#endif
 // Caso esteja desbalanceado e precise rotacionar à direita em torno do nó
 struct NoAVL *rotacaoDireita(struct NoAVL *no)
 {
@@ -72,6 +109,10 @@ struct NoAVL *rotacaoDireita(struct NoAVL *no)
     else
         novaRaiz->altura = 1 + altura(novaRaiz->direita); // Atualiza a altura da nova raiz
 
+    // Atualiza os tamanhos (o nó agora é filho da nova raiz, então vem primeiro)
+    atualizarTamanho(no);
+    atualizarTamanho(novaRaiz);
+
     return novaRaiz; // Retorna a nova raiz após a rotação
 }
 
@@ -96,84 +137,100 @@ struct NoAVL *rotacaoEsquerda(struct NoAVL *no)
     else
         novaRaiz->altura = 1 + altura(novaRaiz->direita); // Atualiza a altura da nova raiz
 
+    // Atualiza os tamanhos (o nó agora é filho da nova raiz, então vem primeiro)
+    atualizarTamanho(no);
+    atualizarTamanho(novaRaiz);
+
     return novaRaiz; // Retorna a nova raiz após a rotação
 }
 
-// Função que vai realizar o balanceamento da árvore
-// Utiliza as funções anteriores para analisar cada caso
-struct NoAVL *balanceamento(struct NoAVL *raiz, int dado)
+// Função para atualizar a altura de um nó a partir das alturas dos filhos
+void atualizarAltura(struct NoAVL *no)
 {
-    // Atualiza a altura do nó atual
-    if (raiz == NULL) // Se a raiz for nula, retorna a raiz
-    {
-        return raiz;
-    }
-    if (altura(raiz->esquerda) > altura(raiz->direita)) // Verifica a altura da subárvore esquerda
-    {
-        raiz->altura = 1 + altura(raiz->esquerda); // Atualiza a altura da raiz
-    }
+    if (altura(no->esquerda) > altura(no->direita)) // Verifica a altura da subárvore esquerda
+        no->altura = 1 + altura(no->esquerda);      // Atualiza a altura do nó
     else
-    {
-        raiz->altura = 1 + altura(raiz->direita); // Atualiza a altura da raiz
-    }
-
-    // Calcula o fator de balanceamento deste nó para verificar se ele se tornou desbalanceado
-    int balanceamento = fatorBalanceamento(raiz); // Calcula o fator de balanceamento da raiz
+        no->altura = 1 + altura(no->direita); // Atualiza a altura do nó
+}
 
-    // Caso de desbalanceamento à esquerda-esquerda
-    if (balanceamento > 1 && dado < raiz->esquerda->dado) // Se o fator de balanceamento for maior que 1 e o dado for menor que o dado da subárvore esquerda
-        return rotacaoDireita(raiz);                      // Realiza rotação à direita
+// Função que vai realizar o balanceamento de um nó
+// Decide o caso de rotação apenas pelos fatores de balanceamento, sem depender do dado inserido ou excluído
+struct NoAVL *balanceamento(struct NoAVL *raiz)
+{
+    atualizarAltura(raiz);  // Atualiza a altura do nó atual
+    atualizarTamanho(raiz); // E o tamanho, que muda mesmo quando a altura não muda
 
-    // Caso de desbalanceamento à direita-direita
-    if (balanceamento < -1 && dado > raiz->direita->dado) // Se o fator de balanceamento for menor que -1 e o dado for maior que o dado da subárvore direita
-        return rotacaoEsquerda(raiz);                     // Realiza rotação à esquerda
+    // Calcula o fator de balanceamento deste nó para verificar se ele se tornou desbalanceado
+    int balanceamento = fatorBalanceamento(raiz);
 
-    // Caso de desbalanceamento à esquerda-direita
-    if (balanceamento > 1 && dado > raiz->esquerda->dado) // Se o fator de balanceamento for maior que 1 e o dado for maior que o dado da subárvore esquerda
+    if (balanceamento > 1) // Subárvore esquerda mais alta
     {
-        raiz->esquerda = rotacaoEsquerda(raiz->esquerda); // Realiza rotação à esquerda na subárvore esquerda da raiz
-        return rotacaoDireita(raiz);                      // Realiza rotação à direita na raiz
+        // Caso esquerda-direita: primeiro rotaciona a subárvore esquerda à esquerda
+        if (fatorBalanceamento(raiz->esquerda) < 0)
+            raiz->esquerda = rotacaoEsquerda(raiz->esquerda);
+        return rotacaoDireita(raiz); // Caso esquerda-esquerda
     }
 
-    // Caso de desbalanceamento à direita-esquerda
-    if (balanceamento < -1 && dado < raiz->direita->dado) // Se o fator de balanceamento for menor que -1 e o dado for menor que o dado da subárvore direita
+    if (balanceamento < -1) // Subárvore direita mais alta
     {
-        raiz->direita = rotacaoDireita(raiz->direita); // Realiza rotação à direita na subárvore direita da raiz
-        return rotacaoEsquerda(raiz);                  // Realiza rotação à esquerda na raiz
+        // Caso direita-esquerda: primeiro rotaciona a subárvore direita à direita
+        if (fatorBalanceamento(raiz->direita) > 0)
+            raiz->direita = rotacaoDireita(raiz->direita);
+        return rotacaoEsquerda(raiz); // Caso direita-direita
     }
 
     // Retorna a raiz inalterada
-    return raiz; // Retorna a raiz após o balanceamento
+    return raiz;
 }
 
-// Função para inserir um novo nó na árvore AVL
-struct NoAVL *inserir(struct NoAVL *raiz, int dado)
+// Função para refazer o balanceamento subindo pelo caminho percorrido
+// O caminho guarda os endereços dos ponteiros que levam a cada nó, da raiz para baixo.
+// O retraçado para no primeiro nó cuja altura não mudou, pois os ancestrais não são afetados.
+// Com ESTATISTICA_ORDEM os tamanhos dos ancestrais mudam mesmo assim, então o resto do caminho
+// ainda tem os tamanhos atualizados (sem rebalancear)
+void retracarCaminho(struct NoAVL **caminho[], int topo)
 {
-    // Verifica se a raiz é nula, indicando que estamos em uma folha da árvore ou que a árvore está vazia
-    if (raiz == NULL)
+    while (topo > 0)
     {
-        // Se a raiz for nula, cria um novo nó com o dado fornecido e o retorna como a nova raiz da árvore
-        return criarNo(dado);
+        struct NoAVL **ligacao = caminho[--topo];
+        int alturaAnterior = (*ligacao)->altura;
+        *ligacao = balanceamento(*ligacao); // Rebalanceia e religa a subárvore ao pai
+        if ((*ligacao)->altura == alturaAnterior)
+            break;
     }
+#ifdef ESTATISTICA_ORDEM
+    while (topo > 0)
+        atualizarTamanho(*caminho[--topo]);
+#endif
+}
 
-    // Se o dado a ser inserido for menor que o valor da raiz atual, insere recursivamente na subárvore esquerda
-    if (dado < raiz->dado)
-    {
-        raiz->esquerda = inserir(raiz->esquerda, dado);
-    }
-    // Se o dado for maior que o valor da raiz atual, insere recursivamente na subárvore direita
-    else if (dado > raiz->dado)
-    {
-        raiz->direita = inserir(raiz->direita, dado);
-    }
-    else
+// Função para inserir um novo nó na árvore AVL
+// Versão iterativa: desce guardando o caminho e retraça apenas enquanto as alturas mudam
+struct NoAVL *inserir(struct NoAVL *raiz, int dado, Arena *arena)
+{
+    struct NoAVL **caminho[ALTURA_MAXIMA_AVL];
+    int topo = 0;
+    struct NoAVL **ligacao = &raiz;
+
+    // Desce até a posição de inserção
+    while (*ligacao != NULL)
     {
-        // Se o dado for igual ao valor da raiz atual, não faz nada (dados iguais não são permitidos na árvore AVL)
-        return raiz;
+        // Se o dado for igual ao valor do nó atual, não faz nada (dados iguais não são permitidos na árvore AVL)
+        if (dado == (*ligacao)->dado)
+            return raiz;
+        caminho[topo++] = ligacao;
+        if (dado < (*ligacao)->dado)
+            ligacao = &(*ligacao)->esquerda;
+        else
+            ligacao = &(*ligacao)->direita;
     }
 
-    // Após a inserção, chama a função de balanceamento para garantir que a árvore permaneça balanceada
-    return balanceamento(raiz, dado);
+    // Cria o novo nó na folha encontrada
+    *ligacao = criarNo(dado, arena);
+
+    // Após a inserção, rebalanceia o caminho de baixo para cima
+    retracarCaminho(caminho, topo);
+    return raiz;
 }
 
 // Encontra o menor valor na árvore AVL
@@ -204,55 +261,111 @@ struct NoAVL* encontrarMaximo(struct NoAVL* no) {
 
 
 // Função para excluir um nó na árvore AVL
-struct NoAVL *excluir(struct NoAVL *raiz, int valor) {
-    if (raiz == NULL) // Verifica se o nó a ser excluído existe ou é nulo
-    {
-        return raiz;
-    }
+// Versão iterativa: usa o mesmo caminho explícito da inserção
+struct NoAVL *excluir(struct NoAVL *raiz, int valor, Arena *arena)
+{
+    struct NoAVL **caminho[ALTURA_MAXIMA_AVL];
+    int topo = 0;
+    struct NoAVL **ligacao = &raiz;
 
-    if (valor < raiz->dado) // Verifica se o dado está à esquerda
-    {
-        raiz->esquerda = excluir(raiz->esquerda, valor); // Chama a função recursivamente até encontrar o nó a ser excluído
-    }
-    else if (valor > raiz->dado) // Verifica se o dado está à direita
+    // Procura o nó a ser excluído
+    while (*ligacao != NULL && (*ligacao)->dado != valor)
     {
-        raiz->direita = excluir(raiz->direita, valor); // Chama a função recursivamente até encontrar o nó a ser excluído
+        caminho[topo++] = ligacao;
+        if (valor < (*ligacao)->dado)
+            ligacao = &(*ligacao)->esquerda;
+        else
+            ligacao = &(*ligacao)->direita;
     }
-    else // Se o nó atual for igual ao valor a ser excluído
+    if (*ligacao == NULL) // O valor não está na árvore
+        return raiz;
+
+    struct NoAVL *alvo = *ligacao;
+    if (alvo->esquerda != NULL && alvo->direita != NULL)
     {
-        // Caso 1: Nó folha ou nó com apenas um filho
-        if (raiz->esquerda == NULL) // Se tiver apenas filhos à direita
+        // Caso 2: Nó com dois filhos
+        // Verifica o balanceamento antes de decidir entre o valor maior à direita da subárvore esquerda ou o menor valor à esquerda da subárvore direita
+        caminho[topo++] = ligacao;
+        if (altura(alvo->esquerda) >= altura(alvo->direita))
         {
-            struct NoAVL *temp = raiz->direita; // Define qual nó filho irá substituir o pai, nesse caso, o nó à direita.
-            free(raiz);                         // Libera o valor do nó da memória
-            return temp;                        // Retorna o nó que irá substituir o nó pai
+            ligacao = &alvo->esquerda;
+            while ((*ligacao)->direita != NULL) // Desce até o maior valor da subárvore esquerda
+            {
+                caminho[topo++] = ligacao;
+                ligacao = &(*ligacao)->direita;
+            }
         }
-        else if (raiz->direita == NULL) // Se tiver apenas filhos à esquerda
+        else
         {
-            struct NoAVL *temp = raiz->esquerda; // Define qual nó filho irá substituir o pai, nesse caso, o nó à esquerda.
-            free(raiz);                         // Libera o valor do nó da memória
-            return temp;                        // Retorna o nó que irá substituir o nó pai
-        }
-
-        // Caso 2: Nó com dois filhos
-        // Verifica o balanceamento antes de decidir entre o valor maior à direita da subárvore esquerda ou o menor valor à esquerda da subárvore direita
-        if (altura(raiz->esquerda) >= altura(raiz->direita)) {
-            // Se a altura da subárvore esquerda for maior, escolhe o maior valor à direita da subárvore esquerda
-            struct NoAVL *temp = encontrarMaximo(raiz->esquerda); // Encontra o maior valor na subárvore esquerda
-            raiz->dado = temp->dado;                              // Copia o valor do sucessor in-order (maior valor na subárvore esquerda) para a raiz atual
-            raiz->esquerda = excluir(raiz->esquerda, temp->dado); // Remove o nó com o valor copiado da subárvore esquerda
-        } else {
-            // Caso contrário, escolhe o menor valor à esquerda da subárvore direita
-            struct NoAVL *temp = encontrarMinimo(raiz->direita); // Encontra o menor valor na subárvore direita
-            raiz->dado = temp->dado;                              // Copia o valor do sucessor in-order (menor valor na subárvore direita) para a raiz atual
-            raiz->direita = excluir(raiz->direita, temp->dado);   // Remove o nó com o valor copiado da subárvore direita
+            ligacao = &alvo->direita;
+            while ((*ligacao)->esquerda != NULL) // Desce até o menor valor da subárvore direita
+            {
+                caminho[topo++] = ligacao;
+                ligacao = &(*ligacao)->esquerda;
+            }
         }
+        alvo->dado = (*ligacao)->dado; // Copia o valor do substituto para o nó a ser excluído
     }
 
-    // Após a exclusão, chama a função de balanceamento para garantir que a árvore permaneça balanceada
-    return balanceamento(raiz, valor);
+    // Caso 1: Nó folha ou nó com apenas um filho (o próprio alvo ou o substituto)
+    struct NoAVL *removido = *ligacao;
+    if (removido->esquerda != NULL)
+        *ligacao = removido->esquerda; // O filho à esquerda substitui o nó
+    else
+        *ligacao = removido->direita; // O filho à direita (ou NULL) substitui o nó
+    liberarNo(arena, removido);
+
+    // Após a exclusão, rebalanceia o caminho de baixo para cima
+    retracarCaminho(caminho, topo);
+    return raiz;
 }
 
+// Função auxiliar para montar a árvore de baixo para cima a partir de um vetor ordenado
+// O elemento do meio vira a raiz e as alturas são calculadas na volta, sem nenhuma rotação
+struct NoAVL *construirBalanceada(int vetor[], int inicio, int fim, Arena *arena)
+{
+    if (inicio > fim) // Caso base: sublista vazia
+        return NULL;
+
+    int meio = inicio + (fim - inicio) / 2;
+    struct NoAVL *no = criarNo(vetor[meio], arena);
+    no->esquerda = construirBalanceada(vetor, inicio, meio - 1, arena);
+    no->direita = construirBalanceada(vetor, meio + 1, fim, arena);
+    atualizarAltura(no);
+    atualizarTamanho(no);
+    return no;
+}
+
+// Função para carregar n chaves de uma vez em uma árvore vazia, em tempo O(n)
+// Se o vetor não estiver estritamente crescente, uma cópia é ordenada em paralelo e os repetidos são descartados
+struct NoAVL *carregarEmLote(int vetor[], int n, Arena *arena)
+{
+    int estritamenteCrescente = 1;
+    for (int i = 1; i < n && estritamenteCrescente; i++)
+        if (vetor[i - 1] >= vetor[i])
+            estritamenteCrescente = 0;
+    if (estritamenteCrescente)
+        return construirBalanceada(vetor, 0, n - 1, arena);
+
+    int *copia = (int *)malloc((size_t)n * sizeof(int));
+    if (copia == NULL)
+    {
+        printf("Erro: Falha ao alocar memória para a carga em lote.\n");
+        exit(-1);
+    }
+    memcpy(copia, vetor, (size_t)n * sizeof(int));
+    ordenarParalelo(copia, n);
+
+    // Remove os valores repetidos (dados iguais não são permitidos na árvore AVL)
+    int unicos = 0;
+    for (int i = 0; i < n; i++)
+        if (unicos == 0 || copia[unicos - 1] != copia[i])
+            copia[unicos++] = copia[i];
+
+    struct NoAVL *raiz = construirBalanceada(copia, 0, unicos - 1, arena);
+    free(copia);
+    return raiz;
+}
 
 // Função para percorrer a árvore em ordem
 void percorrerEmOrdem(struct NoAVL *raiz)
@@ -348,10 +461,314 @@ struct NoAVL *buscarNo(struct NoAVL *raiz, int valor)
         return buscarNo(raiz->direita, valor);
 }
 
+// Passo de buscarEmLote: termina no nó com a chave (ou em NULL) ou desce para o filho do lado dela
+#define PASSO_AVL(no, chave, etapa, terminou)                    \
+    do                                                           \
+    {                                                            \
+        if (no == NULL || no->dado == chave)                     \
+            terminou = 1;                                        \
+        else                                                     \
+            no = chave < no->dado ? no->esquerda : no->direita;  \
+    } while (0)
+
+// Função para buscar n chaves de uma vez; saida[i] recebe o nó de chaves[i] ou NULL
+// As buscas descem intercaladas para sobrepor as faltas de cache (veja BuscaEmLote.h)
+void buscarEmLote(struct NoAVL *raiz, const int chaves[], int n, struct NoAVL *saida[])
+{
+    BUSCA_EM_LOTE(struct NoAVL, raiz, chaves, n, saida, PASSO_AVL);
+}
+
+#ifdef ESTATISTICA_ORDEM
+// Função para encontrar o k-ésimo menor valor (k começando em 0); retorna NULL se k >= tamanho
+struct NoAVL *selecionar(struct NoAVL *raiz, int k)
+{
+    while (raiz != NULL)
+    {
+        int menores = tamanho(raiz->esquerda);
+        if (k == menores)
+            return raiz;
+        if (k < menores)
+            raiz = raiz->esquerda;
+        else
+        {
+            k -= menores + 1;
+            raiz = raiz->direita;
+        }
+    }
+    return NULL;
+}
+
+// Função para calcular o posto de um valor: quantos valores da árvore são menores que ele
+int posto(struct NoAVL *raiz, int valor)
+{
+    int menores = 0;
+    while (raiz != NULL)
+    {
+        if (raiz->dado < valor)
+        {
+            menores += tamanho(raiz->esquerda) + 1;
+            raiz = raiz->direita;
+        }
+        else
+            raiz = raiz->esquerda;
+    }
+    return menores;
+}
+
+// Função para contar quantos valores estão no intervalo [minimo, maximo]
+int contarIntervalo(struct NoAVL *raiz, int minimo, int maximo)
+{
+    if (minimo > maximo)
+        return 0;
+    int ateMaximo = maximo == INT_MAX ? tamanho(raiz) : posto(raiz, maximo + 1);
+    return ateMaximo - posto(raiz, minimo);
+}
+
+// Versões lineares das mesmas consultas, percorrendo a árvore em ordem (usadas no benchmark)
+void contarEmOrdem(struct NoAVL *raiz, int minimo, int maximo, int *quantidade)
+{
+    if (raiz != NULL)
+    {
+        contarEmOrdem(raiz->esquerda, minimo, maximo, quantidade);
+        if (raiz->dado >= minimo && raiz->dado <= maximo)
+            (*quantidade)++;
+        contarEmOrdem(raiz->direita, minimo, maximo, quantidade);
+    }
+}
+
+struct NoAVL *selecionarEmOrdem(struct NoAVL *raiz, int *k)
+{
+    if (raiz == NULL)
+        return NULL;
+    struct NoAVL *encontrado = selecionarEmOrdem(raiz->esquerda, k);
+    if (encontrado != NULL)
+        return encontrado;
+    if ((*k)-- == 0)
+        return raiz;
+    return selecionarEmOrdem(raiz->direita, k);
+}
+#endif
+
+// Função para liberar todos os nós da árvore alocados na arena (ou com malloc, se ela for NULL)
+// Se a arena guarda só os nós desta árvore (arenaExclusiva), basta esvaziá-la: o custo é
+// proporcional ao número de slabs, não de nós. Uma arena dividida com outras árvores não pode
+// ser esvaziada, então os nós desta árvore voltam um a um para a lista livre
+void liberarArvore(struct NoAVL *raiz, Arena *arena, int arenaExclusiva)
+{
+    if (arena != NULL && arenaExclusiva)
+    {
+        arenaEsvaziar(arena);
+        return;
+    }
+    if (raiz != NULL)
+    {
+        liberarArvore(raiz->esquerda, arena, 0);
+        liberarArvore(raiz->direita, arena, 0);
+        liberarNo(arena, raiz);
+    }
+}
+
+// Retorna o tempo atual em segundos, usado nos benchmarks
+double tempoAtual()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Benchmark: vazão de inserção com chaves aleatórias e sequenciais e de exclusão aleatória
+void benchmarkInsercao(int n)
+{
+    int *chaves = (int *)malloc(n * sizeof(int));
+    srand(7);
+    for (int i = 0; i < n; i++)
+        chaves[i] = rand();
+
+    struct NoAVL *raiz = NULL;
+    double inicio = tempoAtual();
+    for (int i = 0; i < n; i++)
+        raiz = inserir(raiz, chaves[i], NULL);
+    double tAleatoria = tempoAtual() - inicio;
+
+    inicio = tempoAtual();
+    for (int i = 0; i < n; i++)
+        raiz = excluir(raiz, chaves[i], NULL);
+    double tExclusao = tempoAtual() - inicio;
+    liberarArvore(raiz, NULL, 0);
+
+    raiz = NULL;
+    inicio = tempoAtual();
+    for (int i = 0; i < n; i++)
+        raiz = inserir(raiz, i, NULL);
+    double tSequencial = tempoAtual() - inicio;
+    printf("Altura apos insercao sequencial de %d chaves: %d\n", n, altura(raiz));
+    liberarArvore(raiz, NULL, 0);
+
+    printf("insercao aleatoria : %7.3f s (%6.2f M/s)\n", tAleatoria, n / tAleatoria / 1e6);
+    printf("insercao sequencial: %7.3f s (%6.2f M/s)\n", tSequencial, n / tSequencial / 1e6);
+    printf("exclusao aleatoria : %7.3f s (%6.2f M/s)\n", tExclusao, n / tExclusao / 1e6);
+
+    inicio = tempoAtual();
+    raiz = carregarEmLote(chaves, n, NULL);
+    double tLote = tempoAtual() - inicio;
+    printf("carga em lote      : %7.3f s (%6.2f M/s), altura %d\n", tLote, n / tLote / 1e6, altura(raiz));
+    liberarArvore(raiz, NULL, 0);
+    free(chaves);
+}
+
+// Benchmark: insere n chaves aleatórias e libera a árvore,
+// primeiro com malloc/free e depois com a arena
+void benchmarkArena(int n)
+{
+    int *chaves = (int *)malloc(n * sizeof(int));
+    srand(42);
+    for (int i = 0; i < n; i++)
+        chaves[i] = rand();
+
+    for (int modo = 0; modo < 2; modo++)
+    {
+        Arena *arena = modo ? criarArena(sizeof(struct NoAVL)) : NULL;
+        struct NoAVL *raiz = NULL;
+
+        double inicio = tempoAtual();
+        for (int i = 0; i < n; i++)
+            raiz = inserir(raiz, chaves[i], arena);
+        double tInsercao = tempoAtual() - inicio;
+
+        inicio = tempoAtual();
+        liberarArvore(raiz, arena, 1);
+        double tLiberacao = tempoAtual() - inicio;
+
+        printf("%-6s | insercao: %7.3f s (%6.2f M/s) | liberacao: %7.3f s\n",
+               modo ? "arena" : "malloc", tInsercao, n / tInsercao / 1e6, tLiberacao);
+        destruirArena(arena);
+    }
+    free(chaves);
+}
+
+#ifdef ESTATISTICA_ORDEM
+// Benchmark: consultas de ordem (k-ésimo, posto e contagem em intervalo) em O(log n)
+// comparadas com o percurso em ordem em O(n)
+void benchmarkEstatistica(int n, int consultas)
+{
+    struct NoAVL *raiz = NULL;
+    srand(11);
+    for (int i = 0; i < n; i++)
+        raiz = inserir(raiz, rand(), NULL);
+    int total = tamanho(raiz);
+    printf("%d chaves distintas, %d consultas\n", total, consultas);
+
+    int *sorteios = (int *)malloc((size_t)consultas * 2 * sizeof(int));
+    if (sorteios == NULL)
+    {
+        printf("Erro: Falha ao alocar memória para as consultas.\n");
+        exit(-1);
+    }
+    for (int i = 0; i < 2 * consultas; i++)
+        sorteios[i] = rand();
+
+    // Percentis: o k-ésimo menor valor
+    long long somaLog = 0, somaLinear = 0;
+    double inicio = tempoAtual();
+    for (int i = 0; i < consultas; i++)
+        somaLog += selecionar(raiz, sorteios[i] % total)->dado;
+    double tSelecionar = tempoAtual() - inicio;
+    int consultasLineares = consultas < 100 ? consultas : 100;
+    inicio = tempoAtual();
+    for (int i = 0; i < consultasLineares; i++)
+    {
+        int k = sorteios[i] % total;
+        somaLinear += selecionarEmOrdem(raiz, &k)->dado;
+    }
+    double tSelecionarLinear = tempoAtual() - inicio;
+
+    // Contagem em intervalo
+    long long contagemLog = 0, contagemLinear = 0;
+    inicio = tempoAtual();
+    for (int i = 0; i < consultas; i++)
+    {
+        int a = sorteios[2 * i], b = sorteios[2 * i + 1];
+        contagemLog += a < b ? contarIntervalo(raiz, a, b) : contarIntervalo(raiz, b, a);
+    }
+    double tContar = tempoAtual() - inicio;
+    inicio = tempoAtual();
+    for (int i = 0; i < consultasLineares; i++)
+    {
+        int a = sorteios[2 * i], b = sorteios[2 * i + 1], quantidade = 0;
+        contarEmOrdem(raiz, a < b ? a : b, a < b ? b : a, &quantidade);
+        contagemLinear += quantidade;
+    }
+    double tContarLinear = tempoAtual() - inicio;
+
+    // Confere as versões O(log n) nas consultas feitas também pelo percurso
+    long long conferirSelecionar = 0, conferirContagem = 0;
+    for (int i = 0; i < consultasLineares; i++)
+    {
+        int a = sorteios[2 * i], b = sorteios[2 * i + 1];
+        conferirSelecionar += selecionar(raiz, sorteios[i] % total)->dado;
+        conferirContagem += a < b ? contarIntervalo(raiz, a, b) : contarIntervalo(raiz, b, a);
+    }
+
+    printf("selecionar      : %10.1f ns/consulta | percurso em ordem: %12.1f ns/consulta (%s)\n",
+           tSelecionar / consultas * 1e9, tSelecionarLinear / consultasLineares * 1e9,
+           conferirSelecionar == somaLinear ? "iguais" : "DIFERENTES");
+    printf("contarIntervalo : %10.1f ns/consulta | percurso em ordem: %12.1f ns/consulta (%s)\n",
+           tContar / consultas * 1e9, tContarLinear / consultasLineares * 1e9,
+           conferirContagem == contagemLinear ? "iguais" : "DIFERENTES");
+    printf("(somas de controle: %lld %lld)\n", somaLog, contagemLog);
+    free(sorteios);
+    liberarArvore(raiz, NULL, 0);
+}
+#endif
+
+// Benchmark: n buscas (metade presentes) uma a uma com buscarNo e em lote com buscarEmLote
+// A árvore é montada com inserções aleatórias, então os nós ficam espalhados pela memória
+void benchmarkBuscaEmLote(int n)
+{
+    int *chaves = (int *)malloc((size_t)n * sizeof(int));
+    int *consultas = (int *)malloc((size_t)n * sizeof(int));
+    struct NoAVL **saida = (struct NoAVL **)malloc((size_t)n * sizeof(struct NoAVL *));
+    if (chaves == NULL || consultas == NULL || saida == NULL)
+    {
+        printf("Erro: Falha ao alocar memória para o benchmark.\n");
+        exit(-1);
+    }
+    srand(3);
+    struct NoAVL *raiz = NULL;
+    for (int i = 0; i < n; i++)
+    {
+        chaves[i] = rand();
+        raiz = inserir(raiz, chaves[i], NULL);
+    }
+    for (int i = 0; i < n; i++)
+        consultas[i] = (i & 1) ? chaves[rand() % n] : rand();
+    printf("%d chaves, %zu bytes por no, altura %d\n", n, sizeof(struct NoAVL), altura(raiz));
+
+    long long encontradasUmaAUma = 0, encontradasLote = 0;
+    double inicio = tempoAtual();
+    for (int i = 0; i < n; i++)
+        encontradasUmaAUma += buscarNo(raiz, consultas[i]) != NULL;
+    double tUmaAUma = tempoAtual() - inicio;
+
+    inicio = tempoAtual();
+    buscarEmLote(raiz, consultas, n, saida);
+    double tLote = tempoAtual() - inicio;
+    for (int i = 0; i < n; i++)
+        encontradasLote += saida[i] != NULL;
+
+    printf("uma a uma: %7.1f ns/busca\n", tUmaAUma / n * 1e9);
+    printf("em lote  : %7.1f ns/busca (%.2fx, %s)\n", tLote / n * 1e9, tUmaAUma / tLote,
+           encontradasLote == encontradasUmaAUma ? "mesmos resultados" : "RESULTADOS DIFERENTES");
+    liberarArvore(raiz, NULL, 0);
+    free(chaves);
+    free(consultas);
+    free(saida);
+}
+
 /* // Teste de altura
 struct NoAVL *raiz = NULL;
-raiz = inserir(raiz, 30);
-raiz = inserir(raiz, 31);
+raiz = inserir(raiz, 30, NULL);
+raiz = inserir(raiz, 31, NULL);
 printf("%d",altura(buscarNo(raiz,NULL))); // ÁRVORE VAZIA = -1
 printf("%d",altura(buscarNo(raiz,31))); // FOLHA = 0;
 mostraArvore(raiz,3);
@@ -362,64 +779,91 @@ ou seja, se ela satisfaz todas as propriedades de uma árvore AVL.
  Teste sua função em diferentes árvores AVL, incluindo árvores corretas
  e incorretas, e verifique se a função retorna os resultados esperados.
 */
-int main()
+int main(int argc, char *argv[])
 {
+    // Executa o benchmark com "bench [n]" em vez da demonstração
+    if (argc > 1 && strcmp(argv[1], "bench") == 0)
+    {
+        int n = argc > 2 ? atoi(argv[2]) : 10000000;
+        benchmarkInsercao(n);
+        benchmarkArena(n);
+        return 0;
+    }
+    // "lote [n]": busca uma a uma contra busca em lote
+    if (argc > 1 && strcmp(argv[1], "lote") == 0)
+    {
+        benchmarkBuscaEmLote(argc > 2 ? atoi(argv[2]) : 4000000);
+        return 0;
+    }
+#ifdef ESTATISTICA_ORDEM
+    // "ordem [n] [consultas]": benchmark das consultas de estatística de ordem
+    if (argc > 1 && strcmp(argv[1], "ordem") == 0)
+    {
+        benchmarkEstatistica(argc > 2 ? atoi(argv[2]) : 1000000, argc > 3 ? atoi(argv[3]) : 1000000);
+        return 0;
+    }
+#endif
 
     struct NoAVL *raiz = NULL;
     //Inserindo elementos na árvore AVL
-    raiz = inserir(raiz, 30);
-    raiz = inserir(raiz, 24);
-    raiz = inserir(raiz, 20);
-    raiz = inserir(raiz, 35);
-    raiz = inserir(raiz, 27);
-    raiz = inserir(raiz, 33);
-    raiz = inserir(raiz, 38);
-    raiz = inserir(raiz, 25);
-    raiz = inserir(raiz, 22);
-    raiz = inserir(raiz, 34);
-    raiz = inserir(raiz, 40);
-    raiz = inserir(raiz, 29);
+    raiz = inserir(raiz, 30, NULL);
+    raiz = inserir(raiz, 24, NULL);
+    raiz = inserir(raiz, 20, NULL);
+    raiz = inserir(raiz, 35, NULL);
+    raiz = inserir(raiz, 27, NULL);
+    raiz = inserir(raiz, 33, NULL);
+    raiz = inserir(raiz, 38, NULL);
+    raiz = inserir(raiz, 25, NULL);
+    raiz = inserir(raiz, 22, NULL);
+    raiz = inserir(raiz, 34, NULL);
+    raiz = inserir(raiz, 40, NULL);
+    raiz = inserir(raiz, 29, NULL);
     mostraArvore(raiz, 3);
    
     printf("\nLetra A - Insere 31 ---------------------------\n");
-    raiz = inserir(raiz, 31);
+    raiz = inserir(raiz, 31, NULL);
     mostraArvore(raiz, 3);
    
     printf("\nLetra B - Insere 15 ---------------------------\n");
-    raiz = inserir(raiz, 15);
+    raiz = inserir(raiz, 15, NULL);
     mostraArvore(raiz, 3);
    
     printf("\nLetra C - Insere 23 ----------------------------\n");
-    raiz = inserir(raiz, 23);
+    raiz = inserir(raiz, 23, NULL);
     mostraArvore(raiz, 3);
    
     printf("\nLetra D - Exclui 24 ---------------------------\n");
-    raiz = excluir(raiz, 24);
+    raiz = excluir(raiz, 24, NULL);
     mostraArvore(raiz, 3);
    
     printf("\nLetra E - Exclui 35 ---------------------------\n");
-    raiz = excluir(raiz, 35);
+    raiz = excluir(raiz, 35, NULL);
     mostraArvore(raiz, 3);
 
      printf("\nLetra F - Inserir 24 ---------------------------\n");
-    raiz = inserir(raiz, 24);
+    raiz = inserir(raiz, 24, NULL);
     mostraArvore(raiz, 3);
 
      printf("\nLetra G - Exclui 27 ---------------------------\n");
-    raiz = excluir(raiz, 27);
+    raiz = excluir(raiz, 27, NULL);
     mostraArvore(raiz, 3);
 
      printf("\nLetra H - Inserir 32 ---------------------------\n");
-    raiz = inserir(raiz, 32);
+    raiz = inserir(raiz, 32, NULL);
     mostraArvore(raiz, 3);
 
      printf("\nLetra I - Exclui 30 ---------------------------\n");
-    raiz = excluir(raiz, 30);
+    raiz = excluir(raiz, 30, NULL);
     mostraArvore(raiz, 3);
     
     printf("\nLetra J - Inserir 21 ---------------------------\n");
-    raiz = inserir(raiz, 21);
+    raiz = inserir(raiz, 21, NULL);
     mostraArvore(raiz, 3);
 
+#ifdef ESTATISTICA_ORDEM
+    printf("\nMediana: %d | posto de 32: %d | valores em [22, 33]: %d\n",
+           selecionar(raiz, tamanho(raiz) / 2)->dado, posto(raiz, 32), contarIntervalo(raiz, 22, 33));
+#endif
+
     return 0;
 }
@@ -0,0 +1,188 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+// Alocador de nós em slabs (arena) compartilhado pelas árvores desta pasta.
+// Cada árvore usa a sua própria arena: os nós são entregues em sequência a partir de
+// blocos grandes (slabs) e os nós liberados voltam para uma lista livre da própria arena.
+// Destruir a árvore inteira custa O(número de slabs), sem percorrer os nós.
+
+#define ARENA_BYTES_SLAB (1 << 18)     // Tamanho de cada slab (256 KiB), também usado como alinhamento
+#define ARENA_INDICE_NULO 0xFFFFFFFFu  // Índice de 32 bits que representa "nenhum nó"
+
+// Cabeçalho gravado no início de cada slab
+typedef struct
+{
+    uint32_t numero; // Posição do slab no vetor de slabs da arena
+} CabecalhoSlab;
+
+// Estrutura da arena
+typedef struct
+{
+    size_t tamanhoNo;     // Tamanho de cada nó, arredondado para múltiplo de 8 bytes
+    uint32_t nosPorSlab;  // Quantidade de nós que cabem em um slab
+    char **slabs;         // Vetor com o endereço de cada slab
+    uint32_t numSlabs;    // Quantidade de slabs alocados
+    uint32_t capacidade;  // Capacidade do vetor de slabs
+    uint32_t usadosUltimo; // Nós já entregues do último slab
+    uint32_t livre;       // Índice do primeiro nó da lista livre (ARENA_INDICE_NULO se vazia)
+    size_t nosAtivos;     // Quantidade de nós atualmente em uso
+} Arena;
+
+// Função para criar uma arena para nós de um tamanho fixo
+static inline Arena *criarArena(size_t tamanhoNo)
+{
+    Arena *arena = (Arena *)malloc(sizeof(Arena));
+    if (arena == NULL)
+    {
+        printf("Erro: Falha ao alocar memória para a arena.\n");
+        exit(-1);
+    }
+    if (tamanhoNo < sizeof(uint32_t))
+        tamanhoNo = sizeof(uint32_t); // O nó livre guarda o índice do próximo nó livre
+    arena->tamanhoNo = (tamanhoNo + 7) & ~(size_t)7;
+    arena->nosPorSlab = (uint32_t)((ARENA_BYTES_SLAB - sizeof(CabecalhoSlab) - 8) / arena->tamanhoNo);
+    arena->slabs = NULL;
+    arena->numSlabs = 0;
+    arena->capacidade = 0;
+    arena->usadosUltimo = 0;
+    arena->livre = ARENA_INDICE_NULO;
+    arena->nosAtivos = 0;
+    return arena;
+}
+
+// Retorna o endereço do primeiro nó de um slab (logo após o cabeçalho, alinhado em 8 bytes)
+static inline char *arenaInicioSlab(char *slab)
+{
+    return slab + ((sizeof(CabecalhoSlab) + 7) & ~(size_t)7);
+}
+
+// Converte um índice de 32 bits em ponteiro para o nó
+static inline void *arenaPonteiro(Arena *arena, uint32_t indice)
+{
+    if (indice == ARENA_INDICE_NULO)
+        return NULL;
+    return arenaInicioSlab(arena->slabs[indice / arena->nosPorSlab]) + (size_t)(indice % arena->nosPorSlab) * arena->tamanhoNo;
+}
+
+// Converte um ponteiro para nó em seu índice de 32 bits
+// O slab é encontrado pelo alinhamento do endereço, então a conversão é O(1)
+static inline uint32_t arenaIndice(Arena *arena, void *no)
+{
+    if (no == NULL)
+        return ARENA_INDICE_NULO;
+    char *slab = (char *)((uintptr_t)no & ~(uintptr_t)(ARENA_BYTES_SLAB - 1));
+    uint32_t numero = ((CabecalhoSlab *)slab)->numero;
+    return numero * arena->nosPorSlab + (uint32_t)(((char *)no - arenaInicioSlab(slab)) / arena->tamanhoNo);
+}
+
+// Função auxiliar para acrescentar um novo slab à arena
+static inline void arenaNovoSlab(Arena *arena)
+{
+    if ((uint64_t)(arena->numSlabs + 1) * arena->nosPorSlab >= ARENA_INDICE_NULO)
+    {
+        printf("Erro: A arena excedeu o limite de índices de 32 bits.\n");
+        exit(-1);
+    }
+    if (arena->numSlabs == arena->capacidade)
+    {
+        arena->capacidade = arena->capacidade ? arena->capacidade * 2 : 16;
+        arena->slabs = (char **)realloc(arena->slabs, arena->capacidade * sizeof(char *));
+        if (arena->slabs == NULL)
+        {
+            printf("Erro: Falha ao alocar memória para a arena.\n");
+            exit(-1);
+        }
+    }
+    char *slab = (char *)aligned_alloc(ARENA_BYTES_SLAB, ARENA_BYTES_SLAB);
+    if (slab == NULL)
+    {
+        printf("Erro: Falha ao alocar memória para a arena.\n");
+        exit(-1);
+    }
+    ((CabecalhoSlab *)slab)->numero = arena->numSlabs;
+    arena->slabs[arena->numSlabs++] = slab;
+    arena->usadosUltimo = 0;
+}
+
+// Função para alocar um nó da arena e retornar o seu índice de 32 bits
+static inline uint32_t arenaAlocarIndice(Arena *arena)
+{
+    uint32_t indice;
+    if (arena->livre != ARENA_INDICE_NULO)
+    {
+        // Reaproveita o primeiro nó da lista livre
+        indice = arena->livre;
+        arena->livre = *(uint32_t *)arenaPonteiro(arena, indice);
+    }
+    else
+    {
+        if (arena->numSlabs == 0 || arena->usadosUltimo == arena->nosPorSlab)
+            arenaNovoSlab(arena);
+        indice = (arena->numSlabs - 1) * arena->nosPorSlab + arena->usadosUltimo++;
+    }
+    arena->nosAtivos++;
+    return indice;
+}
+
+// Função para alocar um nó da arena e retornar o seu endereço
+static inline void *arenaAlocar(Arena *arena)
+{
+    return arenaPonteiro(arena, arenaAlocarIndice(arena));
+}
+
+// Função para devolver um nó, pelo índice, à lista livre da arena
+static inline void arenaLiberarIndice(Arena *arena, uint32_t indice)
+{
+    *(uint32_t *)arenaPonteiro(arena, indice) = arena->livre;
+    arena->livre = indice;
+    arena->nosAtivos--;
+}
+
+// Função para devolver um nó, pelo endereço, à lista livre da arena
+static inline void arenaLiberar(Arena *arena, void *no)
+{
+    arenaLiberarIndice(arena, arenaIndice(arena, no));
+}
+
+// Função para liberar todos os nós da arena de uma vez, mantendo a arena utilizável
+static inline void arenaEsvaziar(Arena *arena)
+{
+    for (uint32_t i = 0; i < arena->numSlabs; i++)
+        free(arena->slabs[i]);
+    arena->numSlabs = 0;
+    arena->usadosUltimo = 0;
+    arena->livre = ARENA_INDICE_NULO;
+    arena->nosAtivos = 0;
+}
+
+// Função para destruir a arena e todos os nós alocados nela
+static inline void destruirArena(Arena *arena)
+{
+    if (arena == NULL)
+        return;
+    arenaEsvaziar(arena);
+    free(arena->slabs);
+    free(arena);
+}
+
+// Funções usadas pelas árvores: se a arena for NULL, o nó é alocado e liberado com malloc/free
+static inline void *alocarNo(Arena *arena, size_t tamanho)
+{
+    if (arena != NULL)
+        return arenaAlocar(arena);
+    return malloc(tamanho);
+}
+
+static inline void liberarNo(Arena *arena, void *no)
+{
+    if (arena != NULL)
+        arenaLiberar(arena, no);
+    else
+        free(no);
+}
+
+#endif
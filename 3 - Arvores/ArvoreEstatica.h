@@ -0,0 +1,186 @@
+#ifndef ARVORE_ESTATICA_H
+#define ARVORE_ESTATICA_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+// Árvore de busca estática ("congelada") guardada em um vetor, sem ponteiros.
+// Qualquer árvore desta pasta pode ser congelada a partir das chaves em ordem (percurso em ordem).
+// Dois layouts:
+//   - Eytzinger (ordem de largura): a raiz fica na posição 1 e os filhos de k em 2k e 2k+1.
+//     Os 16 descendentes de k quatro níveis abaixo ficam em 16k..16k+15, a mesma linha de cache de
+//     64 bytes, então a busca pede essa linha com __builtin_prefetch enquanto desce os quatro níveis.
+//   - van Emde Boas: a árvore (completada até 2^h - 1 posições) é cortada na metade da altura; a
+//     subárvore de cima vem primeiro e depois cada subárvore de baixo, recursivamente. Qualquer
+//     caminho da raiz passa por O(log_B n) blocos para todo tamanho de bloco B, sem conhecer a cache.
+// As buscas não têm desvios dependentes das chaves: cada nível faz k = 2k + (chave < procurada).
+
+#define LAYOUT_EYTZINGER 0
+#define LAYOUT_VEB 1
+#define ESTATICA_ALTURA_MAXIMA 32
+
+typedef struct
+{
+    int *chaves;        // Vetor de chaves no layout escolhido
+    int n;              // Quantidade de chaves reais
+    int layout;
+    int altura;         // Níveis da árvore completa (van Emde Boas)
+    int maiorChave;     // Maior chave real (as posições de preenchimento do vEB usam INT_MAX)
+    // Tabelas do layout van Emde Boas, por profundidade d (raiz em d = 0). O nó de profundidade d
+    // é raiz de uma subárvore de baixo: tamanhoCima[d] e tamanhoBaixo[d] são os tamanhos da
+    // subárvore de cima e de cada subárvore de baixo desse corte, e profundidadeCima[d] a
+    // profundidade da raiz da subárvore de cima
+    int tamanhoCima[ESTATICA_ALTURA_MAXIMA];
+    int tamanhoBaixo[ESTATICA_ALTURA_MAXIMA];
+    int profundidadeCima[ESTATICA_ALTURA_MAXIMA];
+} ArvoreEstatica;
+
+// Aloca um vetor de inteiros alinhado à linha de cache
+static inline int *estaticaAlocar(size_t quantidade)
+{
+    size_t bytes = (quantidade * sizeof(int) + 63) / 64 * 64;
+    int *vetor = (int *)aligned_alloc(64, bytes ? bytes : 64);
+    if (vetor == NULL)
+    {
+        printf("Erro: Falha ao alocar memória para a árvore estática.\n");
+        exit(-1);
+    }
+    return vetor;
+}
+
+// Preenche o vetor Eytzinger percorrendo as posições implícitas em ordem
+static inline void estaticaPreencherEytzinger(int *destino, int n, const int ordenado[], int *proxima, int k)
+{
+    if (k > n)
+        return;
+    estaticaPreencherEytzinger(destino, n, ordenado, proxima, 2 * k);
+    destino[k] = ordenado[(*proxima)++];
+    estaticaPreencherEytzinger(destino, n, ordenado, proxima, 2 * k + 1);
+}
+
+// Calcula as tabelas do corte van Emde Boas de uma subárvore com raiz na profundidade inicio
+static inline void estaticaTabelasVeb(ArvoreEstatica *a, int inicio, int altura)
+{
+    if (altura <= 1)
+        return;
+    int alturaCima = altura / 2, alturaBaixo = altura - alturaCima;
+    int d = inicio + alturaCima;
+    a->tamanhoCima[d] = (1 << alturaCima) - 1;
+    a->tamanhoBaixo[d] = (1 << alturaBaixo) - 1;
+    a->profundidadeCima[d] = inicio;
+    estaticaTabelasVeb(a, inicio, alturaCima);
+    estaticaTabelasVeb(a, d, alturaBaixo);
+}
+
+// Posição no vetor vEB do nó de índice de largura i (raiz = 1) na profundidade d > 0,
+// dadas as posições dos ancestrais em posicoes[0..d-1]
+static inline int estaticaPosicaoVeb(const ArvoreEstatica *a, const int posicoes[], int d, unsigned i)
+{
+    return posicoes[a->profundidadeCima[d]] + a->tamanhoCima[d] + (int)(i & (unsigned)a->tamanhoCima[d]) * a->tamanhoBaixo[d];
+}
+
+// Copia a árvore completa em ordem de largura (origem[1..]) para o layout vEB
+static inline void estaticaPreencherVeb(ArvoreEstatica *a, const int origem[], int posicoes[], int d, unsigned i)
+{
+    if (d >= a->altura)
+        return;
+    posicoes[d] = d == 0 ? 0 : estaticaPosicaoVeb(a, posicoes, d, i);
+    a->chaves[posicoes[d]] = origem[i];
+    estaticaPreencherVeb(a, origem, posicoes, d + 1, 2 * i);
+    estaticaPreencherVeb(a, origem, posicoes, d + 1, 2 * i + 1);
+}
+
+// Congela n chaves em ordem não decrescente em uma árvore estática no layout pedido
+static inline ArvoreEstatica *congelar(const int ordenado[], int n, int layout)
+{
+    ArvoreEstatica *a = (ArvoreEstatica *)calloc(1, sizeof(ArvoreEstatica));
+    if (a == NULL)
+    {
+        printf("Erro: Falha ao alocar memória para a árvore estática.\n");
+        exit(-1);
+    }
+    a->n = n;
+    a->layout = layout;
+    a->maiorChave = n > 0 ? ordenado[n - 1] : INT_MIN;
+    int proxima = 0;
+
+    if (layout == LAYOUT_EYTZINGER)
+    {
+        a->chaves = estaticaAlocar((size_t)n + 1); // A posição 0 não é usada
+        estaticaPreencherEytzinger(a->chaves, n, ordenado, &proxima, 1);
+        return a;
+    }
+
+    // van Emde Boas: completa a árvore até 2^h - 1 posições com INT_MAX depois das chaves reais
+    while (a->altura < ESTATICA_ALTURA_MAXIMA - 1 && (1L << a->altura) - 1 < n)
+        a->altura++;
+    int total = (1 << a->altura) - 1;
+    int *completo = estaticaAlocar((size_t)total + 1);
+    int *preenchido = estaticaAlocar((size_t)total);
+    memcpy(preenchido, ordenado, (size_t)n * sizeof(int));
+    for (int i = n; i < total; i++)
+        preenchido[i] = INT_MAX;
+    estaticaPreencherEytzinger(completo, total, preenchido, &proxima, 1);
+
+    a->chaves = estaticaAlocar((size_t)total);
+    estaticaTabelasVeb(a, 0, a->altura);
+    int posicoes[ESTATICA_ALTURA_MAXIMA];
+    if (total > 0)
+        estaticaPreencherVeb(a, completo, posicoes, 0, 1);
+    free(completo);
+    free(preenchido);
+    return a;
+}
+
+// Retorna um ponteiro para a primeira chave >= chave, ou NULL se não houver
+static inline const int *estaticaLimiteInferior(const ArvoreEstatica *a, int chave)
+{
+    if (a->n == 0 || chave > a->maiorChave)
+        return NULL;
+    if (a->layout == LAYOUT_EYTZINGER)
+    {
+        const int *b = a->chaves;
+        unsigned k = 1;
+        while (k <= (unsigned)a->n)
+        {
+            __builtin_prefetch(b + 16 * k); // Descendentes quatro níveis abaixo
+            k = 2 * k + (b[k] < chave);
+        }
+        // Desfaz as descidas à direita depois da última descida à esquerda
+        k >>= __builtin_ffs((int)~k);
+        return &b[k];
+    }
+
+    int posicoes[ESTATICA_ALTURA_MAXIMA];
+    posicoes[0] = 0;
+    unsigned i = 2 + (a->chaves[0] < chave); // Índice de largura do filho escolhido na raiz
+    for (int d = 1; d < a->altura; d++)
+    {
+        posicoes[d] = estaticaPosicaoVeb(a, posicoes, d, i);
+        i = 2 * i + (a->chaves[posicoes[d]] < chave);
+    }
+    // i está uma profundidade abaixo das folhas; o nó procurado é o último ancestral onde desceu à esquerda
+    int subidas = __builtin_ffs((int)~i);
+    return &a->chaves[posicoes[a->altura - subidas]];
+}
+
+// Retorna 1 se a chave está na árvore estática
+static inline int estaticaContem(const ArvoreEstatica *a, int chave)
+{
+    const int *encontrada = estaticaLimiteInferior(a, chave);
+    return encontrada != NULL && *encontrada == chave;
+}
+
+// Libera a árvore estática
+static inline void liberarEstatica(ArvoreEstatica *a)
+{
+    if (a != NULL)
+    {
+        free(a->chaves);
+        free(a);
+    }
+}
+
+#endif
@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include "Arena.h"
 
 struct NoArvore
 {
@@ -8,9 +9,10 @@ struct NoArvore
     struct NoArvore *direita;
 };
 
-struct NoArvore *criarNo(int dado)
+// Os nós vêm da arena da árvore, passada em cada função; se ela for NULL, os nós usam malloc/free
+struct NoArvore *criarNo(int dado, Arena *arena)
 {
-    struct NoArvore *novoNo = (struct NoArvore *)malloc(sizeof(struct NoArvore));
+    struct NoArvore *novoNo = (struct NoArvore *)alocarNo(arena, sizeof(struct NoArvore));
     if (novoNo == NULL)
     {
         printf("Erro: Falha ao alocar memória para o novo nó.\n");
@@ -22,21 +24,21 @@ struct NoArvore *criarNo(int dado)
     return novoNo;
 }
 
-struct NoArvore *inserir(struct NoArvore *raiz, int dado)
+struct NoArvore *inserir(struct NoArvore *raiz, int dado, Arena *arena)
 {
     if (raiz == NULL)
     {
-        raiz = criarNo(dado);
+        raiz = criarNo(dado, arena);
     }
     else
     {
         if (dado <= raiz->dado)
         {
-            raiz->esquerda = inserir(raiz->esquerda, dado);
+            raiz->esquerda = inserir(raiz->esquerda, dado, arena);
         }
         else
         {
-            raiz->direita = inserir(raiz->direita, dado);
+            raiz->direita = inserir(raiz->direita, dado, arena);
         }
     }
     return raiz;
@@ -52,7 +54,7 @@ struct NoArvore *encontrarMinimo(struct NoArvore *raiz)
     return atual;
 }
 
-struct NoArvore *excluir(struct NoArvore *raiz, int valor)
+struct NoArvore *excluir(struct NoArvore *raiz, int valor, Arena *arena)
 {
     if (raiz == NULL)
     {
@@ -61,11 +63,11 @@ struct NoArvore *excluir(struct NoArvore *raiz, int valor)
 
     if (valor < raiz->dado)
     {
-        raiz->esquerda = excluir(raiz->esquerda, valor);
+        raiz->esquerda = excluir(raiz->esquerda, valor, arena);
     }
     else if (valor > raiz->dado)
     {
-        raiz->direita = excluir(raiz->direita, valor);
+        raiz->direita = excluir(raiz->direita, valor, arena);
     }
     else
     {
@@ -73,20 +75,20 @@ struct NoArvore *excluir(struct NoArvore *raiz, int valor)
         if (raiz->esquerda == NULL)
         {
             struct NoArvore *temp = raiz->direita;
-            free(raiz);
+            liberarNo(arena, raiz);
             return temp;
         }
         else if (raiz->direita == NULL)
         {
             struct NoArvore *temp = raiz->esquerda;
-            free(raiz);
+            liberarNo(arena, raiz);
             return temp;
         }
 
         // Caso 2: Nó com dois filhos, encontra o sucessor in-order (menor valor na subárvore direita)
         struct NoArvore *temp = encontrarMinimo(raiz->direita);
         raiz->dado = temp->dado;
-        raiz->direita = excluir(raiz->direita, temp->dado);
+        raiz->direita = excluir(raiz->direita, temp->dado, arena);
     }
     return raiz;
 }
@@ -145,21 +147,23 @@ void mostraArvore(struct NoArvore *a, int b)
 int main()
 {
     struct NoArvore *raiz = NULL;
+    // A árvore é a única dona da arena, que libera todos os nós de uma vez no final
+    Arena *arena = criarArena(sizeof(struct NoArvore));
 
     // Inserindo elementos na árvore
-    raiz = inserir(raiz, 1);
-    raiz = inserir(raiz, 2);
-    raiz = inserir(raiz, 3);
-    raiz = inserir(raiz, 4);
-    raiz = inserir(raiz, 5);
-    raiz = inserir(raiz, 6);
-    raiz = inserir(raiz, 7);
-    raiz = inserir(raiz, 8);
-    raiz = inserir(raiz, 9);
-    raiz = inserir(raiz, 10);
+    raiz = inserir(raiz, 1, arena);
+    raiz = inserir(raiz, 2, arena);
+    raiz = inserir(raiz, 3, arena);
+    raiz = inserir(raiz, 4, arena);
+    raiz = inserir(raiz, 5, arena);
+    raiz = inserir(raiz, 6, arena);
+    raiz = inserir(raiz, 7, arena);
+    raiz = inserir(raiz, 8, arena);
+    raiz = inserir(raiz, 9, arena);
+    raiz = inserir(raiz, 10, arena);
 
     mostraArvore(raiz, 3);
-    excluir(raiz,5);
+    excluir(raiz,5,arena);
     mostraArvore(raiz,3);
     /* Imprimindo a árvore em ordem
     printf("\nÁrvore em pré-ordem: ");
@@ -174,5 +178,6 @@ int main()
     percorrerPosOrdem(raiz);
     printf("\n");*/
 
+    destruirArena(arena);
     return 0;
 }
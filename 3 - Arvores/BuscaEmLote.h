@@ -0,0 +1,66 @@
+#ifndef BUSCA_EM_LOTE_H
+#define BUSCA_EM_LOTE_H
+
+// Busca em lote compartilhada pelas árvores: n buscas de uma vez, intercaladas para esconder as faltas de cache.
+// Cada nível de uma busca é uma leitura dependente que costuma faltar na cache. Aqui TAMANHO_GRUPO
+// buscas descem juntas, um passo por vez cada: ao fim do passo, a busca pede o próximo nó com
+// __builtin_prefetch e passa a vez para as outras, então as faltas de cache se sobrepõem.
+// Quando uma busca termina, a posição dela no grupo recebe a próxima chave.
+//
+// Só a escolha do próximo nó muda de uma árvore para outra, e ela é o macro PASSO, chamado como
+// PASSO(no, chave, etapa, terminou). Ele deve trocar no pelo próximo nó, ou pôr terminou = 1 e deixar
+// em no a resposta (NULL se a chave não existir). etapa começa em 0 a cada nó e fica com a busca
+// entre um passo e outro, para árvores que gastam mais de um passo por nó (a B-tree lê o nó e
+// depois o vetor de chaves dele)
+
+#define TAMANHO_GRUPO 32 // Quantidade de buscas intercaladas
+
+#define BUSCA_EM_LOTE(TipoNo, raiz, chaves, n, saida, PASSO)                                     \
+    do                                                                                           \
+    {                                                                                            \
+        TipoNo *atualLote[TAMANHO_GRUPO];                                                        \
+        int indiceLote[TAMANHO_GRUPO];                                                           \
+        unsigned char etapaLote[TAMANHO_GRUPO];                                                  \
+        int ativosLote = 0, proximaLote = 0;                                                     \
+        while (ativosLote < TAMANHO_GRUPO && proximaLote < (n))                                  \
+        {                                                                                        \
+            atualLote[ativosLote] = (raiz);                                                      \
+            etapaLote[ativosLote] = 0;                                                           \
+            indiceLote[ativosLote++] = proximaLote++;                                            \
+        }                                                                                        \
+        while (ativosLote > 0)                                                                   \
+        {                                                                                        \
+            int g = 0;                                                                           \
+            while (g < ativosLote)                                                               \
+            {                                                                                    \
+                TipoNo *no = atualLote[g];                                                       \
+                int chave = (chaves)[indiceLote[g]];                                             \
+                int etapa = etapaLote[g];                                                        \
+                int terminou = 0;                                                                \
+                PASSO(no, chave, etapa, terminou);                                               \
+                if (!terminou)                                                                   \
+                {                                                                                \
+                    __builtin_prefetch(no); /* Pedir NULL não causa falha */                     \
+                    atualLote[g] = no;                                                           \
+                    etapaLote[g++] = (unsigned char)etapa;                                       \
+                    continue;                                                                    \
+                }                                                                                \
+                (saida)[indiceLote[g]] = no;                                                     \
+                if (proximaLote < (n)) /* Começa a próxima busca na mesma posição */             \
+                {                                                                                \
+                    atualLote[g] = (raiz);                                                       \
+                    etapaLote[g] = 0;                                                            \
+                    indiceLote[g++] = proximaLote++;                                             \
+                }                                                                                \
+                else /* Sem chaves novas: a última busca ativa ocupa esta posição */             \
+                {                                                                                \
+                    ativosLote--;                                                                \
+                    atualLote[g] = atualLote[ativosLote];                                        \
+                    etapaLote[g] = etapaLote[ativosLote];                                        \
+                    indiceLote[g] = indiceLote[ativosLote];                                      \
+                }                                                                                \
+            }                                                                                    \
+        }                                                                                        \
+    } while (0)
+
+#endif
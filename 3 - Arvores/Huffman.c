@@ -1,17 +1,50 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include "Arena.h"
 
 #define MAX_SIZE 256
+#define TAMANHO_BLOCO (1 << 20)        // Bytes lidos/gravados por vez, para manter a memória limitada
+#define MAX_COMPRIMENTO_CODIGO 15      // Limite do comprimento dos códigos canônicos
+#define BITS_TABELA 12                 // Bits consultados por vez na tabela de decodificação
+#define MAX_SIMBOLOS_ENTRADA 4         // Símbolos resolvidos, no máximo, por consulta à tabela
+#define MIB_BLOCO_PADRAO 2             // Tamanho padrão dos blocos independentes do modo paralelo, em MiB
+#define MAX_MIB_BLOCO 4
+#define KIB_PEDACO_ADAPTATIVO 64       // Tamanho padrão dos pedaços do modo adaptativo, em KiB
+
+// Formato do arquivo comprimido:
+//   "HUF2" | tamanho original (8 bytes) | comprimentos dos códigos (256 x 4 bits) | bits
+// Os códigos são canônicos: dentro de cada comprimento, crescem na ordem dos bytes,
+// então só os comprimentos precisam ser gravados para o decodificador refazer a tabela.
+//
+// Formato do modo paralelo, com blocos independentes de 1 a 4 MiB:
+//   "HUF3" | tamanho do bloco (4 bytes) | blocos | índice | quantidade de blocos (8 bytes) | posição do índice (8 bytes)
+// Cada bloco tem os seus próprios comprimentos (128 bytes) seguidos dos bits. O índice guarda, por bloco,
+// a posição no arquivo, os bytes comprimidos e os bytes originais, então qualquer bloco pode ser lido sozinho.
+//
+// Formato do modo adaptativo (uma passada, da entrada padrão para a saída padrão):
+//   "HUFA" | tamanho do pedaço (4 bytes) | pedaços: bytes originais (4) | bytes comprimidos (4) | bits
+// Um pedaço com 0 bytes originais marca o fim. Os comprimentos não são gravados: o código de cada pedaço
+// vem das estatísticas dos pedaços anteriores, que o decodificador refaz ao descomprimir.
 
 // Estrutura para representar um nó na árvore de Huffman
 typedef struct No
 {
-    char caractere;
-    int frequencia;
+    unsigned char caractere;
+    long long frequencia;
     struct No *esquerda, *direita;
 } No;
 
+// Arena usada para alocar os nós da árvore; se for NULL, os nós usam malloc
+// Cada thread tem a sua, porque a arena não é protegida contra acessos concorrentes
+_Thread_local Arena *arenaNos = NULL;
+
 // Estrutura para representar uma fila de prioridade
 typedef struct
 {
@@ -21,9 +54,9 @@ typedef struct
 } FilaPrioridade;
 
 // Função para criar um novo nó
-No *novoNo(char caractere, int frequencia)
+No *novoNo(unsigned char caractere, long long frequencia)
 {
-    No *no = (No *)malloc(sizeof(No));
+    No *no = (No *)alocarNo(arenaNos, sizeof(No));
     no->caractere = caractere;
     no->frequencia = frequencia;
     no->esquerda = no->direita = NULL;
@@ -97,8 +130,15 @@ void inserir(FilaPrioridade *fila, No *no)
     fila->array[i] = no;
 }
 
+// Função para liberar a fila de prioridade
+void liberarFilaPrioridade(FilaPrioridade *fila)
+{
+    free(fila->array);
+    free(fila);
+}
+
 // Função para construir a árvore de Huffman
-No *construirArvoreHuffman(char caracteres[], int frequencias[], int tamanho)
+No *construirArvoreHuffman(unsigned char caracteres[], long long frequencias[], int tamanho)
 {
     No *esquerda, *direita, *topo;
     FilaPrioridade *fila = criarFilaPrioridade(tamanho);
@@ -118,52 +158,1436 @@ No *construirArvoreHuffman(char caracteres[], int frequencias[], int tamanho)
         inserir(fila, topo);
     }
 
-    return extrairMinimo(fila);
+    No *raiz = extrairMinimo(fila);
+    liberarFilaPrioridade(fila);
+    return raiz;
+}
+
+// Função para construir a árvore a partir da tabela de frequências dos 256 bytes
+// Retorna NULL se nenhum byte tiver frequência positiva
+No *construirArvoreDasFrequencias(long long frequencias[MAX_SIZE])
+{
+    unsigned char caracteres[MAX_SIZE];
+    long long presentes[MAX_SIZE];
+    int tamanho = 0;
+    for (int c = 0; c < MAX_SIZE; c++)
+    {
+        if (frequencias[c] > 0)
+        {
+            caracteres[tamanho] = (unsigned char)c;
+            presentes[tamanho++] = frequencias[c];
+        }
+    }
+    if (tamanho == 0)
+        return NULL;
+    return construirArvoreHuffman(caracteres, presentes, tamanho);
+}
+
+// Função para liberar os nós da árvore
+void liberarArvore(No *raiz)
+{
+    if (raiz == NULL)
+        return;
+    liberarArvore(raiz->esquerda);
+    liberarArvore(raiz->direita);
+    liberarNo(arenaNos, raiz);
 }
 
-// Função para imprimir códigos Huffman a partir da árvore de Huffman
-void imprimirCodigosHuffman(No *raiz, int codigo[], int indice)
+// Função para calcular o comprimento do código de cada folha (a profundidade dela na árvore)
+// Retorna o maior comprimento encontrado
+int calcularComprimentos(No *raiz, int profundidade, unsigned char comprimentos[])
 {
-    if (raiz->esquerda)
+    if (!raiz->esquerda && !raiz->direita)
     {
-        codigo[indice] = 0;
-        imprimirCodigosHuffman(raiz->esquerda, codigo, indice + 1);
+        comprimentos[raiz->caractere] = (unsigned char)(profundidade > 255 ? 255 : profundidade);
+        return profundidade;
     }
+    int esquerda = calcularComprimentos(raiz->esquerda, profundidade + 1, comprimentos);
+    int direita = calcularComprimentos(raiz->direita, profundidade + 1, comprimentos);
+    return esquerda > direita ? esquerda : direita;
+}
 
-    if (raiz->direita)
+// Função para ordenar os símbolos presentes por frequência com radix sort (LSD, um byte por passada)
+// Só são feitas as passadas necessárias para o maior valor; retorna a quantidade de símbolos presentes
+int ordenarFrequencias(const long long frequencias[MAX_SIZE], long long pesos[MAX_SIZE], unsigned char simbolos[MAX_SIZE])
+{
+    long long pesosAux[MAX_SIZE], maior = 0;
+    unsigned char simbolosAux[MAX_SIZE];
+    int n = 0;
+    for (int c = 0; c < MAX_SIZE; c++)
     {
-        codigo[indice] = 1;
-        imprimirCodigosHuffman(raiz->direita, codigo, indice + 1);
+        if (frequencias[c] > 0)
+        {
+            pesos[n] = frequencias[c];
+            simbolos[n++] = (unsigned char)c;
+            if (frequencias[c] > maior)
+                maior = frequencias[c];
+        }
     }
 
-    if (!raiz->esquerda && !raiz->direita)
+    long long *origemPesos = pesos, *destinoPesos = pesosAux;
+    unsigned char *origemSimbolos = simbolos, *destinoSimbolos = simbolosAux;
+    for (int deslocamento = 0; deslocamento < 64 && (maior >> deslocamento) > 0; deslocamento += 8)
+    {
+        int contagem[257] = {0};
+        for (int i = 0; i < n; i++)
+            contagem[((origemPesos[i] >> deslocamento) & 0xFF) + 1]++;
+        for (int d = 0; d < 256; d++)
+            contagem[d + 1] += contagem[d];
+        for (int i = 0; i < n; i++)
+        {
+            int destino = contagem[(origemPesos[i] >> deslocamento) & 0xFF]++;
+            destinoPesos[destino] = origemPesos[i];
+            destinoSimbolos[destino] = origemSimbolos[i];
+        }
+        long long *tempPesos = origemPesos;
+        origemPesos = destinoPesos;
+        destinoPesos = tempPesos;
+        unsigned char *tempSimbolos = origemSimbolos;
+        origemSimbolos = destinoSimbolos;
+        destinoSimbolos = tempSimbolos;
+    }
+    if (origemPesos != pesos)
+    {
+        memcpy(pesos, origemPesos, n * sizeof(long long));
+        memcpy(simbolos, origemSimbolos, n);
+    }
+    return n;
+}
+
+// Função para calcular os comprimentos dos códigos em tempo linear, sem criar nós
+// Com as folhas em ordem crescente, os nós internos também nascem em ordem crescente de peso,
+// então basta intercalar duas filas (folhas e internos) em vetores planos indexados.
+// O pai de cada nó é anotado e as profundidades saem numa passada da raiz para os nós mais antigos.
+// Retorna o maior comprimento (precisa de pelo menos dois símbolos presentes)
+int comprimentosDuasFilas(const long long frequencias[MAX_SIZE], unsigned char comprimentos[MAX_SIZE])
+{
+    long long pesos[MAX_SIZE], pesosInternos[MAX_SIZE];
+    unsigned char simbolos[MAX_SIZE];
+    int paiFolha[MAX_SIZE], paiInterno[MAX_SIZE], profundidade[MAX_SIZE];
+    int n = ordenarFrequencias(frequencias, pesos, simbolos);
+
+    int folha = 0, interno = 0;
+    for (int k = 0; k < n - 1; k++)
+    {
+        // Retira os dois menores da frente das filas; no empate a folha vem antes
+        long long soma = 0;
+        for (int f = 0; f < 2; f++)
+        {
+            if (folha < n && (interno >= k || pesos[folha] <= pesosInternos[interno]))
+            {
+                soma += pesos[folha];
+                paiFolha[folha++] = k;
+            }
+            else
+            {
+                soma += pesosInternos[interno];
+                paiInterno[interno++] = k;
+            }
+        }
+        pesosInternos[k] = soma;
+    }
+
+    memset(comprimentos, 0, MAX_SIZE);
+    profundidade[n - 2] = 0;
+    for (int k = n - 3; k >= 0; k--)
+        profundidade[k] = profundidade[paiInterno[k]] + 1;
+    int maior = 0;
+    for (int i = 0; i < n; i++)
+    {
+        int l = profundidade[paiFolha[i]] + 1;
+        comprimentos[simbolos[i]] = (unsigned char)(l > 255 ? 255 : l);
+        if (l > maior)
+            maior = l;
+    }
+    return maior;
+}
+
+// Função para gerar os comprimentos dos códigos a partir das frequências
+// Enquanto algum código passar de MAX_COMPRIMENTO_CODIGO bits, as frequências são reduzidas
+// à metade (sem chegar a zero) e os comprimentos são refeitos, o que achata a distribuição
+void gerarComprimentos(const long long frequencias[MAX_SIZE], unsigned char comprimentos[MAX_SIZE])
+{
+    long long reduzidas[MAX_SIZE];
+    int presentes = 0, ultimo = 0;
+    memcpy(reduzidas, frequencias, sizeof(reduzidas));
+    memset(comprimentos, 0, MAX_SIZE);
+    for (int c = 0; c < MAX_SIZE; c++)
+    {
+        if (frequencias[c] > 0)
+        {
+            presentes++;
+            ultimo = c;
+        }
+    }
+    if (presentes <= 1)
+    {
+        // Um único símbolo ainda recebe um código de 1 bit
+        if (presentes == 1)
+            comprimentos[ultimo] = 1;
+        return;
+    }
+
+    while (1)
+    {
+        int maior = comprimentosDuasFilas(reduzidas, comprimentos);
+        if (maior <= MAX_COMPRIMENTO_CODIGO)
+            return;
+        for (int c = 0; c < MAX_SIZE; c++)
+            if (reduzidas[c] > 0)
+                reduzidas[c] = (reduzidas[c] >> 1) | 1;
+    }
+}
+
+// Função para atribuir os códigos canônicos a partir dos comprimentos
+// Retorna 0 se os comprimentos não formarem um código de prefixo válido
+int atribuirCodigosCanonicos(const unsigned char comprimentos[MAX_SIZE], uint16_t codigos[MAX_SIZE])
+{
+    int contagem[MAX_COMPRIMENTO_CODIGO + 1] = {0};
+    int proximo[MAX_COMPRIMENTO_CODIGO + 2];
+    for (int c = 0; c < MAX_SIZE; c++)
     {
-        printf("%c: ", raiz->caractere);
-        for (int i = 0; i < indice; ++i)
-            printf("%d", codigo[i]);
+        if (comprimentos[c] > MAX_COMPRIMENTO_CODIGO)
+            return 0;
+        contagem[comprimentos[c]]++;
+    }
+    contagem[0] = 0;
+    int codigo = 0;
+    for (int l = 1; l <= MAX_COMPRIMENTO_CODIGO; l++)
+    {
+        codigo = (codigo + contagem[l - 1]) << 1;
+        proximo[l] = codigo;
+        if (codigo + contagem[l] > (1 << l))
+            return 0;
+    }
+    for (int c = 0; c < MAX_SIZE; c++)
+        if (comprimentos[c] > 0)
+            codigos[c] = (uint16_t)proximo[comprimentos[c]]++;
+    return 1;
+}
+
+// Função para imprimir os códigos canônicos dos bytes presentes
+void imprimirCodigosCanonicos(const unsigned char comprimentos[MAX_SIZE], const uint16_t codigos[MAX_SIZE])
+{
+    for (int c = 0; c < MAX_SIZE; c++)
+    {
+        if (comprimentos[c] == 0)
+            continue;
+        printf("%c: ", c);
+        for (int i = comprimentos[c] - 1; i >= 0; i--)
+            printf("%d", (codigos[c] >> i) & 1);
         printf("\n");
     }
 }
 
+// Escritor de bits com acumulador de 64 bits e buffer de saída de tamanho fixo
+typedef struct
+{
+    FILE *arquivo;
+    unsigned char *buffer;
+    size_t capacidade;  // Com arquivo NULL, o buffer precisa comportar toda a saída
+    size_t usados;
+    uint64_t acumulador;
+    int bits;
+} EscritorBits;
+
+// Função auxiliar para gravar o buffer do escritor no arquivo
+void esvaziarBuffer(EscritorBits *escritor)
+{
+    if (escritor->arquivo == NULL)
+    {
+        printf("Erro: Buffer de saída insuficiente.\n");
+        exit(-1);
+    }
+    if (fwrite(escritor->buffer, 1, escritor->usados, escritor->arquivo) != escritor->usados)
+    {
+        printf("Erro: Falha ao gravar o arquivo de saída.\n");
+        exit(-1);
+    }
+    escritor->usados = 0;
+}
+
+// Função para escrever os comprimento bits menos significativos de codigo (comprimento <= 32)
+static inline void escreverBits(EscritorBits *escritor, uint64_t codigo, int comprimento)
+{
+    escritor->acumulador = (escritor->acumulador << comprimento) | codigo;
+    escritor->bits += comprimento;
+    if (escritor->bits >= 32)
+    {
+        escritor->bits -= 32;
+        uint32_t palavra = (uint32_t)(escritor->acumulador >> escritor->bits);
+        unsigned char *p = escritor->buffer + escritor->usados;
+        p[0] = (unsigned char)(palavra >> 24);
+        p[1] = (unsigned char)(palavra >> 16);
+        p[2] = (unsigned char)(palavra >> 8);
+        p[3] = (unsigned char)palavra;
+        escritor->usados += 4;
+        if (escritor->usados + 4 > escritor->capacidade)
+            esvaziarBuffer(escritor);
+    }
+}
+
+// Função para gravar os bits restantes, completando o último byte com zeros
+void finalizarEscritor(EscritorBits *escritor)
+{
+    while (escritor->bits >= 8)
+    {
+        escritor->bits -= 8;
+        escritor->buffer[escritor->usados++] = (unsigned char)(escritor->acumulador >> escritor->bits);
+    }
+    if (escritor->bits > 0)
+        escritor->buffer[escritor->usados++] = (unsigned char)(escritor->acumulador << (8 - escritor->bits));
+    escritor->bits = 0;
+    if (escritor->arquivo != NULL)
+        esvaziarBuffer(escritor);
+}
+
+// Função para codificar um trecho de bytes com a tabela de códigos
+void codificarBuffer(EscritorBits *escritor, const uint16_t codigos[MAX_SIZE], const unsigned char comprimentos[MAX_SIZE],
+                     const unsigned char dados[], size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+        escreverBits(escritor, codigos[dados[i]], comprimentos[dados[i]]);
+}
+
+// Função auxiliar para alocar um buffer de bloco
+unsigned char *alocarBuffer(size_t tamanho)
+{
+    unsigned char *buffer = (unsigned char *)malloc(tamanho);
+    if (buffer == NULL)
+    {
+        printf("Erro: Falha ao alocar memória para o buffer.\n");
+        exit(-1);
+    }
+    return buffer;
+}
+
+// Função auxiliar para abrir um arquivo, encerrando o programa em caso de erro
+FILE *abrirArquivo(const char *caminho, const char *modo)
+{
+    FILE *arquivo = fopen(caminho, modo);
+    if (arquivo == NULL)
+    {
+        printf("Erro: Não foi possível abrir o arquivo %s.\n", caminho);
+        exit(-1);
+    }
+    return arquivo;
+}
+
+// Retorna o tempo atual em segundos, usado nos relatórios de velocidade
+double tempoAtual()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Função para compactar os comprimentos dos 256 códigos, dois por byte
+void compactarComprimentos(const unsigned char comprimentos[MAX_SIZE], unsigned char compactados[MAX_SIZE / 2])
+{
+    for (int c = 0; c < MAX_SIZE; c += 2)
+        compactados[c / 2] = (unsigned char)((comprimentos[c] << 4) | comprimentos[c + 1]);
+}
+
+// Função para desfazer compactarComprimentos
+void descompactarComprimentos(const unsigned char compactados[MAX_SIZE / 2], unsigned char comprimentos[MAX_SIZE])
+{
+    for (int c = 0; c < MAX_SIZE; c += 2)
+    {
+        comprimentos[c] = compactados[c / 2] >> 4;
+        comprimentos[c + 1] = compactados[c / 2] & 0x0F;
+    }
+}
+
+// Função para gravar os comprimentos dos códigos no arquivo
+void gravarComprimentos(FILE *saida, const unsigned char comprimentos[MAX_SIZE])
+{
+    unsigned char compactados[MAX_SIZE / 2];
+    compactarComprimentos(comprimentos, compactados);
+    fwrite(compactados, 1, sizeof(compactados), saida);
+}
+
+// Função para ler os comprimentos gravados por gravarComprimentos; retorna 0 em caso de erro
+int lerComprimentos(FILE *entrada, unsigned char comprimentos[MAX_SIZE])
+{
+    unsigned char compactados[MAX_SIZE / 2];
+    if (fread(compactados, 1, sizeof(compactados), entrada) != sizeof(compactados))
+        return 0;
+    descompactarComprimentos(compactados, comprimentos);
+    return 1;
+}
+
+// Função para comprimir um arquivo; lê a entrada duas vezes em blocos (frequências e codificação)
+// Retorna o tamanho original em bytes
+long long comprimirArquivo(const char *caminhoEntrada, const char *caminhoSaida)
+{
+    FILE *entrada = abrirArquivo(caminhoEntrada, "rb");
+    FILE *saida = abrirArquivo(caminhoSaida, "wb");
+    unsigned char *bloco = alocarBuffer(TAMANHO_BLOCO);
+
+    // Primeira passagem: frequências dos bytes
+    long long frequencias[MAX_SIZE] = {0};
+    long long total = 0;
+    size_t lidos;
+    while ((lidos = fread(bloco, 1, TAMANHO_BLOCO, entrada)) > 0)
+    {
+        for (size_t i = 0; i < lidos; i++)
+            frequencias[bloco[i]]++;
+        total += lidos;
+    }
+
+    // Cabeçalho com os comprimentos dos códigos canônicos
+    unsigned char comprimentos[MAX_SIZE];
+    uint16_t codigos[MAX_SIZE];
+    gerarComprimentos(frequencias, comprimentos);
+    atribuirCodigosCanonicos(comprimentos, codigos);
+    uint64_t tamanhoOriginal = (uint64_t)total;
+    fwrite("HUF2", 1, 4, saida);
+    fwrite(&tamanhoOriginal, sizeof(tamanhoOriginal), 1, saida);
+    gravarComprimentos(saida, comprimentos);
+
+    // Segunda passagem: codificação
+    EscritorBits escritor = {saida, alocarBuffer(TAMANHO_BLOCO), TAMANHO_BLOCO, 0, 0, 0};
+    rewind(entrada);
+    while ((lidos = fread(bloco, 1, TAMANHO_BLOCO, entrada)) > 0)
+        codificarBuffer(&escritor, codigos, comprimentos, bloco, lidos);
+    finalizarEscritor(&escritor);
+    free(escritor.buffer);
+
+    free(bloco);
+    fclose(entrada);
+    if (fclose(saida) != 0)
+    {
+        printf("Erro: Falha ao gravar o arquivo de saída.\n");
+        exit(-1);
+    }
+    return total;
+}
+
+// Entrada da tabela de decodificação: os símbolos completos nos próximos BITS_TABELA bits
+// e quantos bits eles ocupam (quantidade 0 indica um código mais longo que BITS_TABELA)
+typedef struct
+{
+    unsigned char simbolos[MAX_SIMBOLOS_ENTRADA];
+    unsigned char quantidade;
+    unsigned char bits;
+} EntradaDecodificacao;
+
+// Tabela de decodificação: consulta direta para códigos curtos e busca canônica para os longos
+typedef struct
+{
+    EntradaDecodificacao entradas[1 << BITS_TABELA];
+    uint16_t primeiro[MAX_COMPRIMENTO_CODIGO + 1];  // Primeiro código de cada comprimento
+    uint16_t contagem[MAX_COMPRIMENTO_CODIGO + 1];  // Quantidade de códigos de cada comprimento
+    uint16_t inicio[MAX_COMPRIMENTO_CODIGO + 1];    // Posição do primeiro símbolo de cada comprimento em ordenados
+    unsigned char ordenados[MAX_SIZE];              // Símbolos em ordem de (comprimento, byte)
+    unsigned char comprimentos[MAX_SIZE];           // Comprimento do código de cada byte
+} TabelaDecodificacao;
+
+// Função para montar a tabela de decodificação a partir dos comprimentos
+// Retorna 0 se os comprimentos não formarem um código de prefixo válido
+int montarTabelaDecodificacao(const unsigned char comprimentos[MAX_SIZE], TabelaDecodificacao *tabela)
+{
+    uint16_t codigos[MAX_SIZE];
+    if (!atribuirCodigosCanonicos(comprimentos, codigos))
+        return 0;
+    memcpy(tabela->comprimentos, comprimentos, MAX_SIZE);
+
+    // Dados da busca canônica
+    memset(tabela->contagem, 0, sizeof(tabela->contagem));
+    for (int c = 0; c < MAX_SIZE; c++)
+        tabela->contagem[comprimentos[c]]++;
+    tabela->contagem[0] = 0;
+    int posicao = 0, codigo = 0;
+    for (int l = 1; l <= MAX_COMPRIMENTO_CODIGO; l++)
+    {
+        codigo = (codigo + (l > 1 ? tabela->contagem[l - 1] : 0)) << 1;
+        tabela->primeiro[l] = (uint16_t)codigo;
+        tabela->inicio[l] = (uint16_t)posicao;
+        for (int c = 0; c < MAX_SIZE; c++)
+            if (comprimentos[c] == l)
+                tabela->ordenados[posicao++] = (unsigned char)c;
+    }
+
+    // Tabela de um símbolo: cada código curto preenche todas as entradas que começam com ele
+    unsigned char simbolo[1 << BITS_TABELA];
+    unsigned char comprimento[1 << BITS_TABELA];
+    memset(comprimento, 0, sizeof(comprimento));
+    for (int c = 0; c < MAX_SIZE; c++)
+    {
+        int l = comprimentos[c];
+        if (l == 0 || l > BITS_TABELA)
+            continue;
+        int primeiraEntrada = codigos[c] << (BITS_TABELA - l);
+        for (int i = 0; i < (1 << (BITS_TABELA - l)); i++)
+        {
+            simbolo[primeiraEntrada + i] = (unsigned char)c;
+            comprimento[primeiraEntrada + i] = (unsigned char)l;
+        }
+    }
+
+    // Tabela de vários símbolos: decodifica em sequência enquanto o próximo código couber nos bits restantes
+    for (int i = 0; i < (1 << BITS_TABELA); i++)
+    {
+        EntradaDecodificacao *e = &tabela->entradas[i];
+        int usados = 0;
+        e->quantidade = 0;
+        while (e->quantidade < MAX_SIMBOLOS_ENTRADA)
+        {
+            int j = (i << usados) & ((1 << BITS_TABELA) - 1);
+            int l = comprimento[j];
+            if (l == 0 || usados + l > BITS_TABELA)
+                break;
+            e->simbolos[e->quantidade++] = simbolo[j];
+            usados += l;
+        }
+        e->bits = (unsigned char)usados;
+    }
+    return 1;
+}
+
+// Leitor de bits: acumulador de 64 bits alinhado à esquerda, recarregado 8 bytes por vez
+// Com arquivo NULL, o leitor percorre apenas os bytes já presentes no buffer
+typedef struct
+{
+    FILE *arquivo;
+    unsigned char *buffer;  // Capacidade de 8 bytes além dos dados, para a folga do final
+    size_t posicao, tamanho;
+    int fim;
+    uint64_t acumulador;
+    int bits;
+} LeitorBits;
+
+// Função auxiliar para trazer mais bytes do arquivo, mantendo os que ainda não foram consumidos
+// No fim do arquivo, acrescenta 8 bytes zerados uma única vez (o tamanho original limita a saída)
+void carregarBytes(LeitorBits *leitor)
+{
+    size_t restantes = leitor->tamanho - leitor->posicao;
+    memmove(leitor->buffer, leitor->buffer + leitor->posicao, restantes);
+    leitor->posicao = 0;
+    leitor->tamanho = restantes;
+    if (leitor->arquivo != NULL)
+        leitor->tamanho += fread(leitor->buffer + restantes, 1, TAMANHO_BLOCO - restantes, leitor->arquivo);
+    if (leitor->tamanho == restantes)
+    {
+        if (leitor->fim)
+        {
+            printf("Erro: Arquivo comprimido truncado.\n");
+            exit(-1);
+        }
+        leitor->fim = 1;
+        memset(leitor->buffer + leitor->tamanho, 0, 8);
+        leitor->tamanho += 8;
+    }
+}
+
+// Função para garantir ao menos 57 bits válidos no acumulador
+static inline void recarregarBits(LeitorBits *leitor)
+{
+    if (leitor->tamanho - leitor->posicao < 8)
+    {
+        while (leitor->bits <= 56)
+        {
+            if (leitor->posicao == leitor->tamanho)
+                carregarBytes(leitor);
+            leitor->acumulador |= (uint64_t)leitor->buffer[leitor->posicao++] << (56 - leitor->bits);
+            leitor->bits += 8;
+        }
+        return;
+    }
+    // Caminho rápido: lê 8 bytes de uma vez e avança só os bytes inteiros que couberam
+    uint64_t palavra;
+    memcpy(&palavra, leitor->buffer + leitor->posicao, 8);
+    palavra = __builtin_bswap64(palavra);
+    leitor->acumulador |= palavra >> leitor->bits;
+    leitor->posicao += (63 - leitor->bits) >> 3;
+    leitor->bits |= 56;
+}
+
+// Função para decodificar um símbolo de código mais longo que BITS_TABELA pela busca canônica
+static inline int decodificarLongo(LeitorBits *leitor, const TabelaDecodificacao *tabela)
+{
+    for (int l = BITS_TABELA + 1; l <= MAX_COMPRIMENTO_CODIGO; l++)
+    {
+        unsigned int codigo = (unsigned int)(leitor->acumulador >> (64 - l));
+        if (codigo - tabela->primeiro[l] < tabela->contagem[l])
+        {
+            leitor->acumulador <<= l;
+            leitor->bits -= l;
+            return tabela->ordenados[tabela->inicio[l] + codigo - tabela->primeiro[l]];
+        }
+    }
+    printf("Erro: Código inválido no arquivo comprimido.\n");
+    exit(-1);
+}
+
+// Função para decodificar exatamente n símbolos em destino
+// O destino precisa de MAX_SIMBOLOS_ENTRADA bytes de folga, porque cada entrada da tabela copia
+// todos os seus símbolos de uma vez
+void decodificarParaBuffer(LeitorBits *leitor, const TabelaDecodificacao *tabela, unsigned char destino[], size_t n)
+{
+    size_t usados = 0;
+
+    // Laço principal: com pelo menos 16 símbolos faltando, as quatro consultas não precisam de limite
+    while (n - usados >= 4 * MAX_SIMBOLOS_ENTRADA)
+    {
+        recarregarBits(leitor);
+        // Com 57 bits no acumulador cabem quatro consultas de BITS_TABELA bits
+        for (int k = 0; k < 4; k++)
+        {
+            const EntradaDecodificacao *e = &tabela->entradas[leitor->acumulador >> (64 - BITS_TABELA)];
+            if (e->quantidade == 0)
+            {
+                destino[usados++] = (unsigned char)decodificarLongo(leitor, tabela);
+                break;
+            }
+            memcpy(destino + usados, e->simbolos, MAX_SIMBOLOS_ENTRADA);
+            usados += e->quantidade;
+            leitor->acumulador <<= e->bits;
+            leitor->bits -= e->bits;
+        }
+    }
+    // Final: uma consulta por vez, sem passar de n
+    while (usados < n)
+    {
+        recarregarBits(leitor);
+        const EntradaDecodificacao *e = &tabela->entradas[leitor->acumulador >> (64 - BITS_TABELA)];
+        if (e->quantidade == 0)
+        {
+            destino[usados++] = (unsigned char)decodificarLongo(leitor, tabela);
+            continue;
+        }
+        memcpy(destino + usados, e->simbolos, MAX_SIMBOLOS_ENTRADA);
+        if (e->quantidade <= n - usados)
+        {
+            usados += e->quantidade;
+            leitor->acumulador <<= e->bits;
+            leitor->bits -= e->bits;
+        }
+        else
+        {
+            // Só o primeiro símbolo é consumido, para o próximo trecho continuar do ponto certo
+            int l = tabela->comprimentos[e->simbolos[0]];
+            usados++;
+            leitor->acumulador <<= l;
+            leitor->bits -= l;
+        }
+    }
+}
+
+// Função para descomprimir um arquivo gerado por comprimirArquivo
+// Retorna o tamanho original em bytes
+long long descomprimirArquivo(const char *caminhoEntrada, const char *caminhoSaida)
+{
+    FILE *entrada = abrirArquivo(caminhoEntrada, "rb");
+    FILE *saida = abrirArquivo(caminhoSaida, "wb");
+
+    char assinatura[4];
+    uint64_t tamanhoOriginal;
+    unsigned char comprimentos[MAX_SIZE];
+    TabelaDecodificacao *tabela = (TabelaDecodificacao *)malloc(sizeof(TabelaDecodificacao));
+    if (fread(assinatura, 1, 4, entrada) != 4 || memcmp(assinatura, "HUF2", 4) != 0 ||
+        fread(&tamanhoOriginal, sizeof(tamanhoOriginal), 1, entrada) != 1 ||
+        !lerComprimentos(entrada, comprimentos) || !montarTabelaDecodificacao(comprimentos, tabela))
+    {
+        printf("Erro: %s não é um arquivo comprimido válido.\n", caminhoEntrada);
+        exit(-1);
+    }
+
+    LeitorBits leitor = {entrada, alocarBuffer(TAMANHO_BLOCO + 8), 0, 0, 0, 0, 0};
+    unsigned char *buffer = alocarBuffer(TAMANHO_BLOCO + MAX_SIMBOLOS_ENTRADA);
+    uint64_t restantes = tamanhoOriginal;
+    while (restantes > 0)
+    {
+        size_t n = restantes < TAMANHO_BLOCO ? (size_t)restantes : TAMANHO_BLOCO;
+        decodificarParaBuffer(&leitor, tabela, buffer, n);
+        fwrite(buffer, 1, n, saida);
+        restantes -= n;
+    }
+
+    free(tabela);
+    free(leitor.buffer);
+    free(buffer);
+    fclose(entrada);
+    if (fclose(saida) != 0)
+    {
+        printf("Erro: Falha ao gravar o arquivo de saída.\n");
+        exit(-1);
+    }
+    return (long long)tamanhoOriginal;
+}
+
+// Função para calcular o maior tamanho possível de um bloco comprimido com n bytes originais
+size_t limiteBlocoComprimido(size_t n)
+{
+    return MAX_SIZE / 2 + (n * MAX_COMPRIMENTO_CODIGO + 7) / 8 + 8;
+}
+
+// Função para comprimir um bloco independente em memória: comprimentos (128 bytes) seguidos dos bits
+// Retorna a quantidade de bytes gravados em destino
+size_t comprimirBloco(const unsigned char dados[], size_t n, unsigned char destino[], size_t capacidade)
+{
+    long long frequencias[MAX_SIZE] = {0};
+    for (size_t i = 0; i < n; i++)
+        frequencias[dados[i]]++;
+
+    unsigned char comprimentos[MAX_SIZE];
+    uint16_t codigos[MAX_SIZE];
+    gerarComprimentos(frequencias, comprimentos);
+    atribuirCodigosCanonicos(comprimentos, codigos);
+    compactarComprimentos(comprimentos, destino);
+
+    EscritorBits escritor = {NULL, destino + MAX_SIZE / 2, capacidade - MAX_SIZE / 2, 0, 0, 0};
+    codificarBuffer(&escritor, codigos, comprimentos, dados, n);
+    finalizarEscritor(&escritor);
+    return MAX_SIZE / 2 + escritor.usados;
+}
+
+// Função para descomprimir um bloco gerado por comprimirBloco em destino (com n + MAX_SIMBOLOS_ENTRADA bytes)
+// A origem precisa de 8 bytes de folga depois dos bytes comprimidos
+void descomprimirBloco(unsigned char origem[], size_t bytes, unsigned char destino[], size_t n, TabelaDecodificacao *tabela)
+{
+    unsigned char comprimentos[MAX_SIZE];
+    if (bytes < MAX_SIZE / 2)
+    {
+        printf("Erro: Bloco comprimido corrompido.\n");
+        exit(-1);
+    }
+    descompactarComprimentos(origem, comprimentos);
+    if (!montarTabelaDecodificacao(comprimentos, tabela))
+    {
+        printf("Erro: Bloco comprimido corrompido.\n");
+        exit(-1);
+    }
+    LeitorBits leitor = {NULL, origem + MAX_SIZE / 2, 0, bytes - MAX_SIZE / 2, 0, 0, 0};
+    decodificarParaBuffer(&leitor, tabela, destino, n);
+}
+
+// Funções auxiliares para ler e gravar uma faixa inteira de um arquivo em uma posição dada
+void lerCompleto(int descritor, unsigned char buffer[], size_t n, off_t posicao)
+{
+    while (n > 0)
+    {
+        ssize_t lidos = pread(descritor, buffer, n, posicao);
+        if (lidos <= 0)
+        {
+            printf("Erro: Falha ao ler o arquivo de entrada.\n");
+            exit(-1);
+        }
+        buffer += lidos;
+        n -= (size_t)lidos;
+        posicao += lidos;
+    }
+}
+
+void gravarCompleto(int descritor, const unsigned char buffer[], size_t n, off_t posicao)
+{
+    while (n > 0)
+    {
+        ssize_t gravados = pwrite(descritor, buffer, n, posicao);
+        if (gravados <= 0)
+        {
+            printf("Erro: Falha ao gravar o arquivo de saída.\n");
+            exit(-1);
+        }
+        buffer += gravados;
+        n -= (size_t)gravados;
+        posicao += gravados;
+    }
+}
+
+// Função auxiliar para abrir um arquivo pelo descritor, encerrando o programa em caso de erro
+int abrirDescritor(const char *caminho, int modo)
+{
+    int descritor = open(caminho, modo, 0644);
+    if (descritor < 0)
+    {
+        printf("Erro: Não foi possível abrir o arquivo %s.\n", caminho);
+        exit(-1);
+    }
+    return descritor;
+}
+
+// Entrada do índice de blocos gravado no final do arquivo do modo paralelo
+typedef struct
+{
+    uint64_t posicao;           // Posição do bloco no arquivo comprimido
+    uint32_t bytesComprimidos;
+    uint32_t bytesOriginais;
+} EntradaIndice;
+
+// Resultado de um bloco comprimido, esperando a vez de ser gravado
+typedef struct
+{
+    unsigned char *dados;
+    size_t bytes;
+    size_t original;
+    int pronto;
+} ResultadoBloco;
+
+// Estado compartilhado pelos trabalhadores da compressão paralela
+// Um trabalhador só pega o bloco k se k < gravados + janela, o que limita a memória
+// a janela blocos comprimidos e permite reutilizar o resultado k % janela
+typedef struct
+{
+    int entrada;
+    size_t tamanhoBloco;
+    long long totalBytes;
+    long long numBlocos;
+    int janela;
+    ResultadoBloco *resultados;
+    long long proximo;
+    long long gravados;
+    pthread_mutex_t trava;
+    pthread_cond_t mudou;
+} PoolCompressao;
+
+// Laço de um trabalhador da compressão: lê o bloco com pread, comprime e avisa o thread principal
+void *trabalhadorCompressao(void *arg)
+{
+    PoolCompressao *pool = (PoolCompressao *)arg;
+    unsigned char *dados = alocarBuffer(pool->tamanhoBloco);
+    arenaNos = criarArena(sizeof(No));
+    while (1)
+    {
+        pthread_mutex_lock(&pool->trava);
+        while (pool->proximo < pool->numBlocos && pool->proximo >= pool->gravados + pool->janela)
+            pthread_cond_wait(&pool->mudou, &pool->trava);
+        if (pool->proximo >= pool->numBlocos)
+        {
+            pthread_mutex_unlock(&pool->trava);
+            break;
+        }
+        long long k = pool->proximo++;
+        pthread_mutex_unlock(&pool->trava);
+
+        off_t inicio = (off_t)k * (off_t)pool->tamanhoBloco;
+        size_t n = pool->totalBytes - inicio < (long long)pool->tamanhoBloco ? (size_t)(pool->totalBytes - inicio) : pool->tamanhoBloco;
+        lerCompleto(pool->entrada, dados, n, inicio);
+        ResultadoBloco *r = &pool->resultados[k % pool->janela];
+        r->bytes = comprimirBloco(dados, n, r->dados, limiteBlocoComprimido(pool->tamanhoBloco));
+        r->original = n;
+
+        pthread_mutex_lock(&pool->trava);
+        r->pronto = 1;
+        pthread_cond_broadcast(&pool->mudou);
+        pthread_mutex_unlock(&pool->trava);
+    }
+    destruirArena(arenaNos);
+    free(dados);
+    return NULL;
+}
+
+// Função para comprimir um arquivo em blocos independentes usando um conjunto de threads
+// Os blocos são gravados em ordem pelo thread principal, seguidos do índice
+// Retorna o tamanho original em bytes
+long long comprimirParalelo(const char *caminhoEntrada, const char *caminhoSaida, int numThreads, size_t tamanhoBloco)
+{
+    PoolCompressao pool;
+    struct stat informacoes;
+    pool.entrada = abrirDescritor(caminhoEntrada, O_RDONLY);
+    if (fstat(pool.entrada, &informacoes) != 0)
+    {
+        printf("Erro: Não foi possível obter o tamanho de %s.\n", caminhoEntrada);
+        exit(-1);
+    }
+    pool.tamanhoBloco = tamanhoBloco;
+    pool.totalBytes = informacoes.st_size;
+    pool.numBlocos = (pool.totalBytes + (long long)tamanhoBloco - 1) / (long long)tamanhoBloco;
+    pool.janela = 2 * numThreads;
+    pool.proximo = 0;
+    pool.gravados = 0;
+    pool.resultados = (ResultadoBloco *)calloc(pool.janela, sizeof(ResultadoBloco));
+    for (int j = 0; j < pool.janela; j++)
+        pool.resultados[j].dados = alocarBuffer(limiteBlocoComprimido(tamanhoBloco));
+    pthread_mutex_init(&pool.trava, NULL);
+    pthread_cond_init(&pool.mudou, NULL);
+
+    FILE *saida = abrirArquivo(caminhoSaida, "wb");
+    uint32_t tamanhoGravado = (uint32_t)tamanhoBloco;
+    fwrite("HUF3", 1, 4, saida);
+    fwrite(&tamanhoGravado, sizeof(tamanhoGravado), 1, saida);
+    uint64_t posicao = 4 + sizeof(tamanhoGravado);
+    EntradaIndice *indice = (EntradaIndice *)malloc((pool.numBlocos + 1) * sizeof(EntradaIndice));
+
+    pthread_t threads[numThreads];
+    for (int t = 0; t < numThreads; t++)
+        pthread_create(&threads[t], NULL, trabalhadorCompressao, &pool);
+
+    for (long long k = 0; k < pool.numBlocos; k++)
+    {
+        ResultadoBloco *r = &pool.resultados[k % pool.janela];
+        pthread_mutex_lock(&pool.trava);
+        while (!r->pronto)
+            pthread_cond_wait(&pool.mudou, &pool.trava);
+        pthread_mutex_unlock(&pool.trava);
+
+        if (fwrite(r->dados, 1, r->bytes, saida) != r->bytes)
+        {
+            printf("Erro: Falha ao gravar o arquivo de saída.\n");
+            exit(-1);
+        }
+        indice[k].posicao = posicao;
+        indice[k].bytesComprimidos = (uint32_t)r->bytes;
+        indice[k].bytesOriginais = (uint32_t)r->original;
+        posicao += r->bytes;
+
+        pthread_mutex_lock(&pool.trava);
+        r->pronto = 0;
+        pool.gravados++;
+        pthread_cond_broadcast(&pool.mudou);
+        pthread_mutex_unlock(&pool.trava);
+    }
+    for (int t = 0; t < numThreads; t++)
+        pthread_join(threads[t], NULL);
+
+    // Índice e rodapé
+    uint64_t numBlocos = (uint64_t)pool.numBlocos;
+    fwrite(indice, sizeof(EntradaIndice), pool.numBlocos, saida);
+    fwrite(&numBlocos, sizeof(numBlocos), 1, saida);
+    fwrite(&posicao, sizeof(posicao), 1, saida);
+    if (fclose(saida) != 0)
+    {
+        printf("Erro: Falha ao gravar o arquivo de saída.\n");
+        exit(-1);
+    }
+
+    for (int j = 0; j < pool.janela; j++)
+        free(pool.resultados[j].dados);
+    free(pool.resultados);
+    free(indice);
+    pthread_mutex_destroy(&pool.trava);
+    pthread_cond_destroy(&pool.mudou);
+    close(pool.entrada);
+    return pool.totalBytes;
+}
+
+// Função para ler o cabeçalho, o rodapé e o índice de um arquivo do modo paralelo
+// Retorna o índice alocado e preenche o tamanho do bloco e a quantidade de blocos
+EntradaIndice *lerIndice(int descritor, const char *caminho, size_t *tamanhoBloco, long long *numBlocos)
+{
+    struct stat informacoes;
+    unsigned char cabecalho[8];
+    uint64_t rodape[2];
+    if (fstat(descritor, &informacoes) != 0 || informacoes.st_size < (off_t)(sizeof(cabecalho) + sizeof(rodape)))
+    {
+        printf("Erro: %s não é um arquivo comprimido válido.\n", caminho);
+        exit(-1);
+    }
+    lerCompleto(descritor, cabecalho, sizeof(cabecalho), 0);
+    lerCompleto(descritor, (unsigned char *)rodape, sizeof(rodape), informacoes.st_size - (off_t)sizeof(rodape));
+    uint32_t bloco;
+    memcpy(&bloco, cabecalho + 4, sizeof(bloco));
+    if (memcmp(cabecalho, "HUF3", 4) != 0 || bloco == 0 || bloco > (MAX_MIB_BLOCO << 20) ||
+        rodape[0] > (uint64_t)informacoes.st_size / sizeof(EntradaIndice) ||
+        rodape[1] + rodape[0] * sizeof(EntradaIndice) + sizeof(rodape) != (uint64_t)informacoes.st_size)
+    {
+        printf("Erro: %s não é um arquivo comprimido válido.\n", caminho);
+        exit(-1);
+    }
+
+    *tamanhoBloco = bloco;
+    *numBlocos = (long long)rodape[0];
+    EntradaIndice *indice = (EntradaIndice *)malloc((*numBlocos + 1) * sizeof(EntradaIndice));
+    lerCompleto(descritor, (unsigned char *)indice, *numBlocos * sizeof(EntradaIndice), (off_t)rodape[1]);
+    for (long long k = 0; k < *numBlocos; k++)
+    {
+        if (indice[k].bytesOriginais > bloco || indice[k].bytesComprimidos > limiteBlocoComprimido(bloco) ||
+            indice[k].posicao + indice[k].bytesComprimidos > rodape[1])
+        {
+            printf("Erro: Índice de blocos corrompido em %s.\n", caminho);
+            exit(-1);
+        }
+    }
+    return indice;
+}
+
+// Estado compartilhado pelos trabalhadores da descompressão paralela
+typedef struct
+{
+    int entrada, saida;
+    EntradaIndice *indice;
+    long long numBlocos;
+    size_t tamanhoBloco;
+    long long proximo;
+    pthread_mutex_t trava;
+} PoolDescompressao;
+
+// Laço de um trabalhador da descompressão: cada bloco é gravado direto na sua posição com pwrite
+void *trabalhadorDescompressao(void *arg)
+{
+    PoolDescompressao *pool = (PoolDescompressao *)arg;
+    unsigned char *origem = alocarBuffer(limiteBlocoComprimido(pool->tamanhoBloco) + 8);
+    unsigned char *destino = alocarBuffer(pool->tamanhoBloco + MAX_SIMBOLOS_ENTRADA);
+    TabelaDecodificacao *tabela = (TabelaDecodificacao *)malloc(sizeof(TabelaDecodificacao));
+    while (1)
+    {
+        pthread_mutex_lock(&pool->trava);
+        long long k = pool->proximo++;
+        pthread_mutex_unlock(&pool->trava);
+        if (k >= pool->numBlocos)
+            break;
+
+        EntradaIndice *e = &pool->indice[k];
+        lerCompleto(pool->entrada, origem, e->bytesComprimidos, (off_t)e->posicao);
+        descomprimirBloco(origem, e->bytesComprimidos, destino, e->bytesOriginais, tabela);
+        gravarCompleto(pool->saida, destino, e->bytesOriginais, (off_t)k * (off_t)pool->tamanhoBloco);
+    }
+    free(tabela);
+    free(origem);
+    free(destino);
+    return NULL;
+}
+
+// Função para descomprimir em paralelo um arquivo gerado por comprimirParalelo
+// Retorna o tamanho original em bytes
+long long descomprimirParalelo(const char *caminhoEntrada, const char *caminhoSaida, int numThreads)
+{
+    PoolDescompressao pool;
+    pool.entrada = abrirDescritor(caminhoEntrada, O_RDONLY);
+    pool.indice = lerIndice(pool.entrada, caminhoEntrada, &pool.tamanhoBloco, &pool.numBlocos);
+    pool.saida = abrirDescritor(caminhoSaida, O_WRONLY | O_CREAT | O_TRUNC);
+    pool.proximo = 0;
+    pthread_mutex_init(&pool.trava, NULL);
+
+    long long total = 0;
+    for (long long k = 0; k < pool.numBlocos; k++)
+        total += pool.indice[k].bytesOriginais;
+    if (ftruncate(pool.saida, total) != 0)
+    {
+        printf("Erro: Falha ao gravar o arquivo de saída.\n");
+        exit(-1);
+    }
+
+    pthread_t threads[numThreads];
+    for (int t = 0; t < numThreads; t++)
+        pthread_create(&threads[t], NULL, trabalhadorDescompressao, &pool);
+    for (int t = 0; t < numThreads; t++)
+        pthread_join(threads[t], NULL);
+
+    pthread_mutex_destroy(&pool.trava);
+    free(pool.indice);
+    close(pool.entrada);
+    if (close(pool.saida) != 0)
+    {
+        printf("Erro: Falha ao gravar o arquivo de saída.\n");
+        exit(-1);
+    }
+    return total;
+}
+
+// Função para descomprimir só um bloco, indo direto a ele pelo índice
+// Retorna a quantidade de bytes originais do bloco
+long long descomprimirUmBloco(const char *caminhoEntrada, const char *caminhoSaida, long long bloco)
+{
+    size_t tamanhoBloco;
+    long long numBlocos;
+    int entrada = abrirDescritor(caminhoEntrada, O_RDONLY);
+    EntradaIndice *indice = lerIndice(entrada, caminhoEntrada, &tamanhoBloco, &numBlocos);
+    if (bloco < 0 || bloco >= numBlocos)
+    {
+        printf("Erro: Bloco %lld inexistente (o arquivo tem %lld blocos).\n", bloco, numBlocos);
+        exit(-1);
+    }
+
+    EntradaIndice *e = &indice[bloco];
+    unsigned char *origem = alocarBuffer(e->bytesComprimidos + 8);
+    unsigned char *destino = alocarBuffer(e->bytesOriginais + MAX_SIMBOLOS_ENTRADA);
+    TabelaDecodificacao *tabela = (TabelaDecodificacao *)malloc(sizeof(TabelaDecodificacao));
+    lerCompleto(entrada, origem, e->bytesComprimidos, (off_t)e->posicao);
+    descomprimirBloco(origem, e->bytesComprimidos, destino, e->bytesOriginais, tabela);
+
+    FILE *saida = abrirArquivo(caminhoSaida, "wb");
+    fwrite(destino, 1, e->bytesOriginais, saida);
+    if (fclose(saida) != 0)
+    {
+        printf("Erro: Falha ao gravar o arquivo de saída.\n");
+        exit(-1);
+    }
+    long long bytes = e->bytesOriginais;
+    free(tabela);
+    free(origem);
+    free(destino);
+    free(indice);
+    close(entrada);
+    return bytes;
+}
+
+// Função para atualizar as estatísticas do modo adaptativo com um pedaço já codificado
+// As contagens antigas perdem metade do peso a cada pedaço, para o código acompanhar mudanças na entrada
+void atualizarEstatisticas(long long estatisticas[MAX_SIZE], const unsigned char dados[], size_t n)
+{
+    long long contagem[MAX_SIZE] = {0};
+    for (size_t i = 0; i < n; i++)
+        contagem[dados[i]]++;
+    for (int c = 0; c < MAX_SIZE; c++)
+        estatisticas[c] = (estatisticas[c] >> 1) + contagem[c];
+}
+
+// Função para gerar os comprimentos do próximo pedaço a partir das estatísticas
+// Todos os bytes recebem peso mínimo 1, porque o pedaço seguinte pode conter qualquer um deles
+void comprimentosAdaptativos(const long long estatisticas[MAX_SIZE], unsigned char comprimentos[MAX_SIZE])
+{
+    long long pesos[MAX_SIZE];
+    for (int c = 0; c < MAX_SIZE; c++)
+        pesos[c] = estatisticas[c] + 1;
+    gerarComprimentos(pesos, comprimentos);
+}
+
+// Função para ler até n bytes, esperando a entrada (arquivo, pipe ou socket) encher o pedaço ou acabar
+size_t lerPedaco(FILE *entrada, unsigned char buffer[], size_t n)
+{
+    size_t lidos = 0, r;
+    while (lidos < n && (r = fread(buffer + lidos, 1, n - lidos, entrada)) > 0)
+        lidos += r;
+    return lidos;
+}
+
+// Função para comprimir em uma única passada no modo adaptativo
+// Cada pedaço é codificado com o código montado a partir dos pedaços anteriores, que o decodificador
+// também conhece, então os cabeçalhos dos pedaços só levam os tamanhos. A latência fica limitada
+// ao tamanho do pedaço. Retorna o tamanho original e preenche a quantidade de bytes gravados
+long long comprimirAdaptativo(FILE *entrada, FILE *saida, size_t tamanhoPedaco, long long *bytesGravados)
+{
+    unsigned char *dados = alocarBuffer(tamanhoPedaco);
+    size_t capacidade = limiteBlocoComprimido(tamanhoPedaco);
+    unsigned char *bits = alocarBuffer(capacidade);
+    long long estatisticas[MAX_SIZE] = {0};
+    unsigned char comprimentos[MAX_SIZE];
+    uint16_t codigos[MAX_SIZE];
+    long long total = 0;
+
+    uint32_t tamanhoGravado = (uint32_t)tamanhoPedaco;
+    fwrite("HUFA", 1, 4, saida);
+    fwrite(&tamanhoGravado, sizeof(tamanhoGravado), 1, saida);
+    *bytesGravados = 4 + sizeof(tamanhoGravado);
+
+    comprimentosAdaptativos(estatisticas, comprimentos);
+    atribuirCodigosCanonicos(comprimentos, codigos);
+    while (1)
+    {
+        uint32_t cabecalho[2];
+        size_t n = lerPedaco(entrada, dados, tamanhoPedaco);
+        EscritorBits escritor = {NULL, bits, capacidade, 0, 0, 0};
+        codificarBuffer(&escritor, codigos, comprimentos, dados, n);
+        finalizarEscritor(&escritor);
+
+        // Cabeçalho do pedaço: bytes originais e bytes comprimidos (um pedaço vazio marca o fim)
+        cabecalho[0] = (uint32_t)n;
+        cabecalho[1] = (uint32_t)escritor.usados;
+        if (fwrite(cabecalho, sizeof(cabecalho), 1, saida) != 1 ||
+            fwrite(bits, 1, escritor.usados, saida) != escritor.usados || fflush(saida) != 0)
+        {
+            printf("Erro: Falha ao gravar a saída.\n");
+            exit(-1);
+        }
+        *bytesGravados += sizeof(cabecalho) + escritor.usados;
+        total += n;
+        if (n == 0)
+            break;
+
+        atualizarEstatisticas(estatisticas, dados, n);
+        comprimentosAdaptativos(estatisticas, comprimentos);
+        atribuirCodigosCanonicos(comprimentos, codigos);
+    }
+
+    free(dados);
+    free(bits);
+    return total;
+}
+
+// Função para descomprimir em uma única passada a saída de comprimirAdaptativo
+// Retorna o tamanho original
+long long descomprimirAdaptativo(FILE *entrada, FILE *saida)
+{
+    char assinatura[4];
+    uint32_t tamanhoPedaco;
+    if (fread(assinatura, 1, 4, entrada) != 4 || memcmp(assinatura, "HUFA", 4) != 0 ||
+        fread(&tamanhoPedaco, sizeof(tamanhoPedaco), 1, entrada) != 1 || tamanhoPedaco == 0 ||
+        tamanhoPedaco > (MAX_MIB_BLOCO << 20))
+    {
+        printf("Erro: A entrada não está no formato adaptativo.\n");
+        exit(-1);
+    }
+
+    size_t capacidade = limiteBlocoComprimido(tamanhoPedaco);
+    unsigned char *bits = alocarBuffer(capacidade + 8);
+    unsigned char *dados = alocarBuffer(tamanhoPedaco + MAX_SIMBOLOS_ENTRADA);
+    TabelaDecodificacao *tabela = (TabelaDecodificacao *)malloc(sizeof(TabelaDecodificacao));
+    long long estatisticas[MAX_SIZE] = {0};
+    unsigned char comprimentos[MAX_SIZE];
+    long long total = 0;
+
+    comprimentosAdaptativos(estatisticas, comprimentos);
+    montarTabelaDecodificacao(comprimentos, tabela);
+    while (1)
+    {
+        uint32_t cabecalho[2];
+        if (fread(cabecalho, sizeof(cabecalho), 1, entrada) != 1 || cabecalho[0] > tamanhoPedaco ||
+            cabecalho[1] > capacidade || fread(bits, 1, cabecalho[1], entrada) != cabecalho[1])
+        {
+            printf("Erro: Entrada adaptativa truncada ou corrompida.\n");
+            exit(-1);
+        }
+        if (cabecalho[0] == 0)
+            break;
+
+        LeitorBits leitor = {NULL, bits, 0, cabecalho[1], 0, 0, 0};
+        decodificarParaBuffer(&leitor, tabela, dados, cabecalho[0]);
+        if (fwrite(dados, 1, cabecalho[0], saida) != cabecalho[0] || fflush(saida) != 0)
+        {
+            printf("Erro: Falha ao gravar a saída.\n");
+            exit(-1);
+        }
+        total += cabecalho[0];
+
+        atualizarEstatisticas(estatisticas, dados, cabecalho[0]);
+        comprimentosAdaptativos(estatisticas, comprimentos);
+        montarTabelaDecodificacao(comprimentos, tabela);
+    }
+
+    free(bits);
+    free(dados);
+    free(tabela);
+    return total;
+}
+
+// Benchmark: razão de compressão e velocidade do modo adaptativo (uma passada) e do estático (duas passadas)
+// O arquivo temporário recebe as saídas comprimidas, e as descompressões vão para /dev/null
+void benchmarkAdaptativo(const char *caminhoEntrada, const char *caminhoTemporario, size_t tamanhoPedaco)
+{
+    struct stat informacoes;
+    double inicio = tempoAtual();
+    long long total = comprimirArquivo(caminhoEntrada, caminhoTemporario);
+    double tempoCompressao = tempoAtual() - inicio;
+    stat(caminhoTemporario, &informacoes);
+    long long bytesEstatico = informacoes.st_size;
+    inicio = tempoAtual();
+    descomprimirArquivo(caminhoTemporario, "/dev/null");
+    double tempoDescompressao = tempoAtual() - inicio;
+    printf("Estatico (2 passadas):   razao %.3f, compressao %7.1f MB/s, descompressao %7.1f MB/s\n",
+           total ? (double)bytesEstatico / total : 0.0, total / 1e6 / tempoCompressao, total / 1e6 / tempoDescompressao);
+
+    FILE *entrada = abrirArquivo(caminhoEntrada, "rb");
+    FILE *saida = abrirArquivo(caminhoTemporario, "wb");
+    long long bytesAdaptativo;
+    inicio = tempoAtual();
+    comprimirAdaptativo(entrada, saida, tamanhoPedaco, &bytesAdaptativo);
+    tempoCompressao = tempoAtual() - inicio;
+    fclose(entrada);
+    fclose(saida);
+    entrada = abrirArquivo(caminhoTemporario, "rb");
+    saida = abrirArquivo("/dev/null", "wb");
+    inicio = tempoAtual();
+    descomprimirAdaptativo(entrada, saida);
+    tempoDescompressao = tempoAtual() - inicio;
+    fclose(entrada);
+    fclose(saida);
+    printf("Adaptativo (%4zu KiB):   razao %.3f, compressao %7.1f MB/s, descompressao %7.1f MB/s\n",
+           tamanhoPedaco >> 10, total ? (double)bytesAdaptativo / total : 0.0,
+           total / 1e6 / tempoCompressao, total / 1e6 / tempoDescompressao);
+}
+
+// Função para imprimir o relatório de velocidade de uma operação
+void imprimirVelocidade(FILE *destino, const char *operacao, long long bytes, double segundos)
+{
+    fprintf(destino, "%s: %lld bytes em %.3f s (%.1f MB/s)\n", operacao, bytes, segundos,
+           segundos > 0 ? bytes / 1e6 / segundos : 0.0);
+}
+
+
+// Custo total (em bits) de uma tabela de frequências codificada com os comprimentos dados
+long long custoCodigo(const long long frequencias[MAX_SIZE], const unsigned char comprimentos[MAX_SIZE])
+{
+    long long custo = 0;
+    for (int c = 0; c < MAX_SIZE; c++)
+        custo += frequencias[c] * comprimentos[c];
+    return custo;
+}
+
+// Benchmark: reconstruções por segundo com a fila de prioridade e nós (construirArvoreHuffman)
+// e com as duas filas em vetores planos (comprimentosDuasFilas), sobre tabelas de frequências
+// parecidas com as de blocos reais (distribuições de Zipf com expoentes variados)
+void benchmarkConstrucao(int repeticoes)
+{
+    enum { NUM_TABELAS = 64 };
+    static long long tabelas[NUM_TABELAS][MAX_SIZE];
+    srand(42);
+    for (int t = 0; t < NUM_TABELAS; t++)
+    {
+        int presentes = 2 + rand() % (MAX_SIZE - 1);
+        double expoente = 0.5 + (rand() % 150) / 100.0;
+        double peso = 1 << 21;
+        memset(tabelas[t], 0, sizeof(tabelas[t]));
+        for (int i = 0; i < presentes; i++)
+        {
+            // O produto de (1 + expoente / i) cresce como i^expoente
+            tabelas[t][(i * 37 + t) % MAX_SIZE] = 1 + (long long)peso;
+            peso /= 1.0 + expoente / (i + 1);
+        }
+    }
+
+    unsigned char comprimentos[MAX_SIZE], comprimentosLinear[MAX_SIZE];
+    long long diferencas = 0, verificacao = 0;
+    for (int t = 0; t < NUM_TABELAS; t++)
+    {
+        No *raiz = construirArvoreDasFrequencias(tabelas[t]);
+        memset(comprimentos, 0, sizeof(comprimentos));
+        calcularComprimentos(raiz, 0, comprimentos);
+        liberarArvore(raiz);
+        comprimentosDuasFilas(tabelas[t], comprimentosLinear);
+        diferencas += custoCodigo(tabelas[t], comprimentos) != custoCodigo(tabelas[t], comprimentosLinear);
+    }
+
+    double inicio = tempoAtual();
+    for (int r = 0; r < repeticoes; r++)
+    {
+        No *raiz = construirArvoreDasFrequencias(tabelas[r % NUM_TABELAS]);
+        verificacao += calcularComprimentos(raiz, 0, comprimentos);
+        liberarArvore(raiz);
+    }
+    double tempoHeap = tempoAtual() - inicio;
+
+    inicio = tempoAtual();
+    for (int r = 0; r < repeticoes; r++)
+        verificacao += comprimentosDuasFilas(tabelas[r % NUM_TABELAS], comprimentosLinear);
+    double tempoLinear = tempoAtual() - inicio;
+
+    printf("%d reconstrucoes (%s, verificacao %lld)\n", repeticoes,
+           diferencas == 0 ? "custos iguais" : "CUSTOS DIFERENTES", verificacao);
+    printf("Fila de prioridade com nos: %10.0f reconstrucoes/s\n", repeticoes / tempoHeap);
+    printf("Duas filas em vetor plano:  %10.0f reconstrucoes/s\n", repeticoes / tempoLinear);
+}
+
 // Função principal
-int main()
+// Uso: Huffman                        (mostra os códigos de uma string digitada)
+//      Huffman c entrada saida        (comprime)
+//      Huffman d entrada saida        (descomprime)
+//      Huffman cp entrada saida [threads] [MiB por bloco]   (comprime em blocos, em paralelo)
+//      Huffman dp entrada saida [threads]                   (descomprime os blocos em paralelo)
+//      Huffman db entrada saida bloco                       (descomprime só um bloco)
+//      Huffman bench [repeticoes]                           (compara os construtores de códigos)
+//      Huffman ca [KiB por pedaço] < entrada > saida        (comprime em uma passada, modo adaptativo)
+//      Huffman da < entrada > saida                         (descomprime o modo adaptativo)
+//      Huffman bencha entrada temporario [KiB por pedaço]   (compara o modo adaptativo com o estático)
+int main(int argc, char *argv[])
 {
-    char caracteres[MAX_SIZE];
-    int frequencias[MAX_SIZE] = {0};
+    // Os nós da árvore vêm da arena, liberada de uma só vez no final
+    arenaNos = criarArena(sizeof(No));
+
+    if (argc > 1 && strcmp(argv[1], "bench") == 0)
+    {
+        benchmarkConstrucao(argc > 2 ? atoi(argv[2]) : 200000);
+        destruirArena(arenaNos);
+        return 0;
+    }
+
+    if (argc == 4 && (strcmp(argv[1], "c") == 0 || strcmp(argv[1], "d") == 0))
+    {
+        double inicio = tempoAtual();
+        if (argv[1][0] == 'c')
+        {
+            long long total = comprimirArquivo(argv[2], argv[3]);
+            imprimirVelocidade(stdout, "Compressao", total, tempoAtual() - inicio);
+        }
+        else
+        {
+            long long total = descomprimirArquivo(argv[2], argv[3]);
+            imprimirVelocidade(stdout, "Descompressao", total, tempoAtual() - inicio);
+        }
+        destruirArena(arenaNos);
+        return 0;
+    }
+
+    // Modo paralelo em blocos independentes
+    if (argc >= 4 && (strcmp(argv[1], "cp") == 0 || strcmp(argv[1], "dp") == 0 || strcmp(argv[1], "db") == 0))
+    {
+        int threads = argc > 4 ? atoi(argv[4]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+        if (threads < 1)
+            threads = 1;
+        double inicio = tempoAtual();
+        if (strcmp(argv[1], "cp") == 0)
+        {
+            int mib = argc > 5 ? atoi(argv[5]) : MIB_BLOCO_PADRAO;
+            if (mib < 1 || mib > MAX_MIB_BLOCO)
+            {
+                printf("Erro: O tamanho do bloco deve ficar entre 1 e %d MiB.\n", MAX_MIB_BLOCO);
+                exit(-1);
+            }
+            long long total = comprimirParalelo(argv[2], argv[3], threads, (size_t)mib << 20);
+            imprimirVelocidade(stdout, "Compressao paralela", total, tempoAtual() - inicio);
+        }
+        else if (strcmp(argv[1], "dp") == 0)
+        {
+            long long total = descomprimirParalelo(argv[2], argv[3], threads);
+            imprimirVelocidade(stdout, "Descompressao paralela", total, tempoAtual() - inicio);
+        }
+        else
+        {
+            if (argc < 5)
+            {
+                printf("Uso: %s db entrada saida bloco\n", argv[0]);
+                exit(-1);
+            }
+            long long total = descomprimirUmBloco(argv[2], argv[3], atoll(argv[4]));
+            imprimirVelocidade(stdout, "Descompressao do bloco", total, tempoAtual() - inicio);
+        }
+        destruirArena(arenaNos);
+        return 0;
+    }
+
+    // Modo adaptativo: da entrada padrão para a saída padrão, então o relatório vai para stderr
+    if (argc >= 2 && (strcmp(argv[1], "ca") == 0 || strcmp(argv[1], "da") == 0))
+    {
+        double inicio = tempoAtual();
+        if (argv[1][0] == 'c')
+        {
+            int kib = argc > 2 ? atoi(argv[2]) : KIB_PEDACO_ADAPTATIVO;
+            if (kib < 1 || kib > (MAX_MIB_BLOCO << 10))
+            {
+                fprintf(stderr, "Erro: O tamanho do pedaço deve ficar entre 1 e %d KiB.\n", MAX_MIB_BLOCO << 10);
+                exit(-1);
+            }
+            long long gravados;
+            long long total = comprimirAdaptativo(stdin, stdout, (size_t)kib << 10, &gravados);
+            imprimirVelocidade(stderr, "Compressao adaptativa", total, tempoAtual() - inicio);
+        }
+        else
+        {
+            long long total = descomprimirAdaptativo(stdin, stdout);
+            imprimirVelocidade(stderr, "Descompressao adaptativa", total, tempoAtual() - inicio);
+        }
+        destruirArena(arenaNos);
+        return 0;
+    }
+    if (argc >= 4 && strcmp(argv[1], "bencha") == 0)
+    {
+        benchmarkAdaptativo(argv[2], argv[3], (size_t)(argc > 4 ? atoi(argv[4]) : KIB_PEDACO_ADAPTATIVO) << 10);
+        destruirArena(arenaNos);
+        return 0;
+    }
+
+    char texto[MAX_SIZE];
+    long long frequencias[MAX_SIZE] = {0};
 
     printf("Digite uma string: ");
-    gets(caracteres);
+    if (fgets(texto, sizeof(texto), stdin) == NULL)
+        texto[0] = '\0';
+    texto[strcspn(texto, "\n")] = '\0';
 
-    int tamanho = strlen(caracteres);
+    int tamanho = strlen(texto);
 
     for (int i = 0; i < tamanho; ++i)
-        frequencias[caracteres[i]]++;
+        frequencias[(unsigned char)texto[i]]++;
 
-    No *raiz = construirArvoreHuffman(caracteres, frequencias, tamanho);
+    unsigned char comprimentos[MAX_SIZE];
+    uint16_t codigos[MAX_SIZE];
+    gerarComprimentos(frequencias, comprimentos);
+    atribuirCodigosCanonicos(comprimentos, codigos);
 
-    int codigo[MAX_SIZE], indice = 0;
     printf("Codigos Huffman:\n");
-    imprimirCodigosHuffman(raiz, codigo, indice);
+    imprimirCodigosCanonicos(comprimentos, codigos);
 
+    destruirArena(arenaNos);
     return 0;
 }
@@ -0,0 +1,124 @@
+#ifndef ORDENACAO_PARALELA_H
+#define ORDENACAO_PARALELA_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+// Ordenação paralela de vetores de inteiros, usada pelas cargas em lote das árvores.
+// O vetor é dividido em pedaços ordenados com qsort, cada um em uma thread,
+// e depois os pedaços são intercalados dois a dois, também em paralelo, até sobrar um só.
+
+#define ORDENACAO_MINIMO_POR_THREAD 65536 // Abaixo disso não compensa criar threads
+
+// Dados de uma tarefa (ordenar um pedaço ou intercalar dois pedaços vizinhos)
+typedef struct
+{
+    int *origem;
+    int *destino;
+    int inicio, meio, fim;
+} TarefaOrdenacao;
+
+// Função de comparação para o qsort
+static inline int compararInteiros(const void *a, const void *b)
+{
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+// Verifica se o vetor está em ordem não decrescente
+static inline int estaOrdenado(const int vetor[], int n)
+{
+    for (int i = 1; i < n; i++)
+        if (vetor[i - 1] > vetor[i])
+            return 0;
+    return 1;
+}
+
+// Ordena um pedaço do vetor (executada por uma thread)
+static inline void *ordenarPedaco(void *arg)
+{
+    TarefaOrdenacao *t = (TarefaOrdenacao *)arg;
+    qsort(t->origem + t->inicio, t->fim - t->inicio, sizeof(int), compararInteiros);
+    return NULL;
+}
+
+// Intercala origem[inicio..meio) e origem[meio..fim) em destino[inicio..fim) (executada por uma thread)
+static inline void *intercalarPedacos(void *arg)
+{
+    TarefaOrdenacao *t = (TarefaOrdenacao *)arg;
+    int i = t->inicio, j = t->meio, k = t->inicio;
+    while (i < t->meio && j < t->fim)
+        t->destino[k++] = t->origem[j] < t->origem[i] ? t->origem[j++] : t->origem[i++];
+    while (i < t->meio)
+        t->destino[k++] = t->origem[i++];
+    while (j < t->fim)
+        t->destino[k++] = t->origem[j++];
+    return NULL;
+}
+
+// Função para ordenar um vetor usando todos os núcleos disponíveis
+static inline void ordenarParalelo(int vetor[], int n)
+{
+    long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+    int pedacos = 1;
+    while (pedacos * 2 <= nucleos && (long)n / (pedacos * 2) >= ORDENACAO_MINIMO_POR_THREAD)
+        pedacos *= 2;
+    if (pedacos == 1)
+    {
+        qsort(vetor, n, sizeof(int), compararInteiros);
+        return;
+    }
+
+    pthread_t threads[pedacos];
+    TarefaOrdenacao tarefas[pedacos];
+    int limites[pedacos + 1];
+    for (int p = 0; p <= pedacos; p++)
+        limites[p] = (int)((long)n * p / pedacos);
+
+    // Fase 1: cada thread ordena o seu pedaço
+    for (int p = 0; p < pedacos; p++)
+    {
+        tarefas[p].origem = vetor;
+        tarefas[p].inicio = limites[p];
+        tarefas[p].fim = limites[p + 1];
+        pthread_create(&threads[p], NULL, ordenarPedaco, &tarefas[p]);
+    }
+    for (int p = 0; p < pedacos; p++)
+        pthread_join(threads[p], NULL);
+
+    // Fase 2: intercala os pedaços em rodadas, alternando entre o vetor e um auxiliar
+    int *auxiliar = (int *)malloc((size_t)n * sizeof(int));
+    if (auxiliar == NULL)
+    {
+        printf("Erro: Falha ao alocar memória para a ordenação.\n");
+        exit(-1);
+    }
+    int *origem = vetor, *destino = auxiliar;
+    for (int largura = 1; largura < pedacos; largura *= 2)
+    {
+        int numTarefas = 0;
+        for (int p = 0; p < pedacos; p += 2 * largura)
+        {
+            tarefas[numTarefas].origem = origem;
+            tarefas[numTarefas].destino = destino;
+            tarefas[numTarefas].inicio = limites[p];
+            tarefas[numTarefas].meio = limites[p + largura];
+            tarefas[numTarefas].fim = limites[p + 2 * largura];
+            pthread_create(&threads[numTarefas], NULL, intercalarPedacos, &tarefas[numTarefas]);
+            numTarefas++;
+        }
+        for (int t = 0; t < numTarefas; t++)
+            pthread_join(threads[t], NULL);
+        int *temp = origem;
+        origem = destino;
+        destino = temp;
+    }
+    if (origem != vetor)
+        memcpy(vetor, origem, (size_t)n * sizeof(int));
+    free(auxiliar);
+}
+
+#endif
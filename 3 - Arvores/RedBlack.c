@@ -1,183 +1,979 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "OrdenacaoParalela.h"
 
 // Definição dos possíveis valores de cor
 #define VERMELHO 0
 #define PRETO 1
 
+#define NULO 0 // O índice 0 é reservado e faz o papel de NULL (é um nó preto que nunca é alterado)
+
+// Compile com -DESTATISTICA_ORDEM para guardar em cada nó o tamanho da subárvore (o nó passa a 20 bytes).
+// Com ele, selecionar, posto e contarIntervalo custam O(log n) em vez de um percurso em ordem O(n)
+
 // Definição da estrutura de um nó da árvore Red-Black
+// Os filhos e o pai são índices de 32 bits no vetor de nós, e a cor fica no bit menos significativo
+// do campo do pai. Assim o nó ocupa 16 bytes, contra 32 com int cor e três ponteiros
 struct No
 {
     int valor;
-    int cor;
-    struct No *esquerda, *direita, *pai;
+    uint32_t esquerda, direita;
+    uint32_t paiCor; // (índice do pai << 1) | cor
+#ifdef ESTATISTICA_ORDEM
+    uint32_t tamanho; // Quantidade de nós da subárvore (0 no nó NULO)
+#endif
 };
 
 typedef struct No No;
 
-// Função para criar um novo nó
-No *criarNo(int valor)
+// Vetor com os nós da árvore. Índices continuam válidos quando o vetor cresce com realloc, e os nós
+// excluídos formam uma lista livre encadeada pelo campo esquerda. A Arena.h também entrega índices
+// de 32 bits, mas converte índice em ponteiro com uma divisão; aqui o acesso é só pool.nos[i]
+typedef struct
+{
+    No *nos;
+    uint32_t usados;     // Nós já entregues, incluindo o nó 0
+    uint32_t capacidade;
+    uint32_t livre;      // Primeiro nó da lista livre (NULO se vazia)
+} PoolNos;
+
+PoolNos pool = {NULL, 0, 0, NULO};
+
+// Funções de acesso ao pai e à cor guardados juntos em paiCor
+static inline uint32_t pai(uint32_t no)
+{
+    return pool.nos[no].paiCor >> 1;
+}
+
+static inline int cor(uint32_t no)
+{
+    return (int)(pool.nos[no].paiCor & 1);
+}
+
+static inline void definirPai(uint32_t no, uint32_t novoPai)
+{
+    pool.nos[no].paiCor = (novoPai << 1) | (pool.nos[no].paiCor & 1);
+}
+
+static inline void definirCor(uint32_t no, int novaCor)
+{
+    pool.nos[no].paiCor = (pool.nos[no].paiCor & ~1u) | (uint32_t)novaCor;
+}
+
+#ifdef ESTATISTICA_ORDEM
+static inline uint32_t tamanho(uint32_t no)
+{
+    return pool.nos[no].tamanho;
+}
+
+// Função para recalcular o tamanho de um nó a partir dos filhos
+static inline void atualizarTamanho(uint32_t no)
+{
+    pool.nos[no].tamanho = 1 + tamanho(pool.nos[no].esquerda) + tamanho(pool.nos[no].direita);
+}
+#else
+#define atualizarTamanho(no) ((void)0)
+#endif
+
+// Função auxiliar para verificar se um nó é vermelho (NULO é preto)
+int ehVermelho(uint32_t no)
+{
+    return cor(no) == VERMELHO;
+}
+
+// Função para garantir espaço para pelo menos capacidade nós no vetor
+void reservarNos(uint32_t capacidade)
 {
-    No *novoNo = (No *)malloc(sizeof(No));
-    novoNo->valor = valor;
-    novoNo->cor = VERMELHO;
-    novoNo->esquerda = novoNo->direita = novoNo->pai = NULL;
+    if (capacidade <= pool.capacidade)
+        return;
+    if (capacidade > (1u << 31))
+    {
+        printf("Erro: A árvore excedeu o limite de índices de 31 bits.\n");
+        exit(-1);
+    }
+    No *nos = (No *)realloc(pool.nos, (size_t)capacidade * sizeof(No));
+    if (nos == NULL)
+    {
+        printf("Erro: Falha ao alocar memória para os nós.\n");
+        exit(-1);
+    }
+    pool.nos = nos;
+    pool.capacidade = capacidade;
+    if (pool.usados == 0)
+    {
+        // Nó 0: sentinela preto sem filhos
+        pool.nos[NULO].valor = 0;
+        pool.nos[NULO].esquerda = pool.nos[NULO].direita = NULO;
+        pool.nos[NULO].paiCor = (NULO << 1) | PRETO;
+#ifdef ESTATISTICA_ORDEM
+        pool.nos[NULO].tamanho = 0;
+#endif
+        pool.usados = 1;
+    }
+}
+
+// Função para criar um novo nó e retornar o seu índice
+// Pode mover o vetor de nós, então ponteiros para nós não devem ser guardados durante a chamada
+uint32_t criarNo(int valor)
+{
+    uint32_t novoNo;
+    if (pool.livre != NULO)
+    {
+        novoNo = pool.livre;
+        pool.livre = pool.nos[novoNo].esquerda;
+    }
+    else
+    {
+        if (pool.usados == pool.capacidade)
+        {
+            // Dobra sem passar de 2^31: perto do limite pede exatamente 2^31 e, cheio, um nó a mais,
+            // para que reservarNos acuse o limite em vez de o dobro dar a volta para 0
+            uint32_t novaCapacidade = pool.capacidade == 0 ? 1024
+                                    : pool.capacidade < (1u << 30) ? pool.capacidade * 2
+                                    : pool.capacidade < (1u << 31) ? (1u << 31)
+                                                                   : pool.capacidade + 1;
+            reservarNos(novaCapacidade);
+        }
+        novoNo = pool.usados++;
+    }
+    pool.nos[novoNo].valor = valor;
+    pool.nos[novoNo].esquerda = pool.nos[novoNo].direita = NULO;
+    pool.nos[novoNo].paiCor = (NULO << 1) | VERMELHO;
+#ifdef ESTATISTICA_ORDEM
+    pool.nos[novoNo].tamanho = 1;
+#endif
     return novoNo;
 }
 
+// Função para devolver um nó à lista livre
+void liberarNo(uint32_t no)
+{
+    pool.nos[no].esquerda = pool.livre;
+    pool.livre = no;
+}
+
 // Função para fazer a rotação à esquerda
-void rotacaoEsquerda(No **raiz, No *x)
-{
-    No *y = x->direita;
-    x->direita = y->esquerda;
-    if (y->esquerda != NULL)
-        y->esquerda->pai = x;
-    y->pai = x->pai;
-    if (x->pai == NULL)
+void rotacaoEsquerda(uint32_t *raiz, uint32_t x)
+{
+    No *nos = pool.nos;
+    uint32_t y = nos[x].direita;
+    uint32_t xPai = pai(x);
+    nos[x].direita = nos[y].esquerda;
+    if (nos[y].esquerda != NULO)
+        definirPai(nos[y].esquerda, x);
+    definirPai(y, xPai);
+    if (xPai == NULO)
         *raiz = y;
-    else if (x == x->pai->esquerda)
-        x->pai->esquerda = y;
+    else if (x == nos[xPai].esquerda)
+        nos[xPai].esquerda = y;
     else
-        x->pai->direita = y;
-    y->esquerda = x;
-    x->pai = y;
+        nos[xPai].direita = y;
+    nos[y].esquerda = x;
+    definirPai(x, y);
+    atualizarTamanho(x); // x agora é filho de y, então vem primeiro
+    atualizarTamanho(y);
 }
 
 // Função para fazer a rotação à direita
-void rotacaoDireita(No **raiz, No *x)
-{
-    No *y = x->esquerda;
-    x->esquerda = y->direita;
-    if (y->direita != NULL)
-        y->direita->pai = x;
-    y->pai = x->pai;
-    if (x->pai == NULL)
+void rotacaoDireita(uint32_t *raiz, uint32_t x)
+{
+    No *nos = pool.nos;
+    uint32_t y = nos[x].esquerda;
+    uint32_t xPai = pai(x);
+    nos[x].esquerda = nos[y].direita;
+    if (nos[y].direita != NULO)
+        definirPai(nos[y].direita, x);
+    definirPai(y, xPai);
+    if (xPai == NULO)
         *raiz = y;
-    else if (x == x->pai->direita)
-        x->pai->direita = y;
+    else if (x == nos[xPai].direita)
+        nos[xPai].direita = y;
     else
-        x->pai->esquerda = y;
-    y->direita = x;
-    x->pai = y;
+        nos[xPai].esquerda = y;
+    nos[y].direita = x;
+    definirPai(x, y);
+    atualizarTamanho(x); // x agora é filho de y, então vem primeiro
+    atualizarTamanho(y);
 }
 
 // Função para balancear a árvore após a inserção de um nó
-void corrigirViolacao(No **raiz, No *z)
+void corrigirViolacao(uint32_t *raiz, uint32_t z)
 {
-    while (z != *raiz && z->pai->cor == VERMELHO)
+    No *nos = pool.nos;
+    while (z != *raiz && ehVermelho(pai(z)))
     {
-        if (z->pai == z->pai->pai->esquerda)
+        uint32_t zPai = pai(z), avo = pai(zPai);
+        if (zPai == nos[avo].esquerda)
         {
-            No *y = z->pai->pai->direita;
-            if (y != NULL && y->cor == VERMELHO)
+            uint32_t y = nos[avo].direita;
+            if (ehVermelho(y))
             {
-                z->pai->cor = PRETO;
-                y->cor = PRETO;
-                z->pai->pai->cor = VERMELHO;
-                z = z->pai->pai;
+                definirCor(zPai, PRETO);
+                definirCor(y, PRETO);
+                definirCor(avo, VERMELHO);
+                z = avo;
             }
             else
             {
-                if (z == z->pai->direita)
+                if (z == nos[zPai].direita)
                 {
-                    z = z->pai;
+                    z = zPai;
                     rotacaoEsquerda(raiz, z);
+                    zPai = pai(z);
                 }
-                z->pai->cor = PRETO;
-                z->pai->pai->cor = VERMELHO;
-                rotacaoDireita(raiz, z->pai->pai);
+                definirCor(zPai, PRETO);
+                definirCor(avo, VERMELHO);
+                rotacaoDireita(raiz, avo);
             }
         }
         else
         {
-            No *y = z->pai->pai->esquerda;
-            if (y != NULL && y->cor == VERMELHO)
+            uint32_t y = nos[avo].esquerda;
+            if (ehVermelho(y))
             {
-                z->pai->cor = PRETO;
-                y->cor = PRETO;
-                z->pai->pai->cor = VERMELHO;
-                z = z->pai->pai;
+                definirCor(zPai, PRETO);
+                definirCor(y, PRETO);
+                definirCor(avo, VERMELHO);
+                z = avo;
             }
             else
             {
-                if (z == z->pai->esquerda)
+                if (z == nos[zPai].esquerda)
                 {
-                    z = z->pai;
+                    z = zPai;
                     rotacaoDireita(raiz, z);
+                    zPai = pai(z);
                 }
-                z->pai->cor = PRETO;
-                z->pai->pai->cor = VERMELHO;
-                rotacaoEsquerda(raiz, z->pai->pai);
+                definirCor(zPai, PRETO);
+                definirCor(avo, VERMELHO);
+                rotacaoEsquerda(raiz, avo);
             }
         }
     }
-    (*raiz)->cor = PRETO;
+    definirCor(*raiz, PRETO);
 }
 
 // Função para inserir um novo nó na árvore Red-Black
-void inserir(No **raiz, int valor)
+void inserir(uint32_t *raiz, int valor)
 {
-    No *z = criarNo(valor);
-    No *y = NULL;
-    No *x = *raiz;
+    uint32_t z = criarNo(valor);
+    No *nos = pool.nos;
+    uint32_t y = NULO;
+    uint32_t x = *raiz;
 
-    while (x != NULL)
+    while (x != NULO)
     {
         y = x;
-        if (z->valor < x->valor)
-            x = x->esquerda;
+#ifdef ESTATISTICA_ORDEM
+        nos[x].tamanho++; // O novo nó vai ficar nesta subárvore
+#endif
+        if (valor < nos[x].valor)
+            x = nos[x].esquerda;
         else
-            x = x->direita;
+            x = nos[x].direita;
     }
-    z->pai = y;
-    if (y == NULL)
+    definirPai(z, y);
+    if (y == NULO)
         *raiz = z;
-    else if (z->valor < y->valor)
-        y->esquerda = z;
+    else if (valor < nos[y].valor)
+        nos[y].esquerda = z;
     else
-        y->direita = z;
+        nos[y].direita = z;
 
     corrigirViolacao(raiz, z);
 }
 
+// Função auxiliar para montar a árvore de baixo para cima a partir de um vetor ordenado
+// Os nós com profundidade maior ou igual a profundidadeVermelha ficam vermelhos e os demais pretos
+uint32_t construirBalanceada(int vetor[], int inicio, int fim, int profundidade, int profundidadeVermelha, uint32_t noPai)
+{
+    if (inicio > fim) // Caso base: sublista vazia
+        return NULO;
+
+    int meio = inicio + (fim - inicio) / 2;
+    uint32_t no = criarNo(vetor[meio]);
+    definirCor(no, profundidade >= profundidadeVermelha ? VERMELHO : PRETO);
+    definirPai(no, noPai);
+    uint32_t esquerda = construirBalanceada(vetor, inicio, meio - 1, profundidade + 1, profundidadeVermelha, no);
+    uint32_t direita = construirBalanceada(vetor, meio + 1, fim, profundidade + 1, profundidadeVermelha, no);
+    pool.nos[no].esquerda = esquerda;
+    pool.nos[no].direita = direita;
+    atualizarTamanho(no);
+    return no;
+}
+
+// Função para carregar n valores de uma vez em uma árvore vazia, em tempo O(n)
+// Dividindo sempre pelo meio, todo caminho da raiz até NULL passa pelos níveis 0..floor(log2(n+1))-1
+// completos; só o último nível (incompleto) é pintado de vermelho, o que mantém a mesma
+// quantidade de nós pretos em todos os caminhos e nenhum vermelho com filho vermelho.
+// Se o vetor não estiver ordenado, uma cópia é ordenada em paralelo antes da montagem
+void carregarEmLote(uint32_t *raiz, int vetor[], int n)
+{
+    int profundidadeVermelha = 0;
+    while ((2L << profundidadeVermelha) <= (long)n + 1)
+        profundidadeVermelha++;
+    reservarNos(pool.usados + (uint32_t)n + 1);
+
+    if (estaOrdenado(vetor, n))
+    {
+        *raiz = construirBalanceada(vetor, 0, n - 1, 0, profundidadeVermelha, NULO);
+        return;
+    }
+
+    int *copia = (int *)malloc((size_t)n * sizeof(int));
+    if (copia == NULL)
+    {
+        printf("Erro: Falha ao alocar memória para a carga em lote.\n");
+        exit(-1);
+    }
+    memcpy(copia, vetor, (size_t)n * sizeof(int));
+    ordenarParalelo(copia, n);
+    *raiz = construirBalanceada(copia, 0, n - 1, 0, profundidadeVermelha, NULO);
+    free(copia);
+}
+
+// Função para buscar um valor; retorna o nó ou NULO se não existir
+uint32_t buscar(uint32_t raiz, int valor)
+{
+    No *nos = pool.nos;
+    while (raiz != NULO && nos[raiz].valor != valor)
+        raiz = valor < nos[raiz].valor ? nos[raiz].esquerda : nos[raiz].direita;
+    return raiz;
+}
+
+// Função auxiliar para encontrar o nó mínimo (mais à esquerda)
+uint32_t minimo(uint32_t no)
+{
+    if (no == NULO)
+        return NULO;
+    while (pool.nos[no].esquerda != NULO)
+        no = pool.nos[no].esquerda;
+    return no;
+}
+
+// Função auxiliar para encontrar o nó máximo (mais à direita)
+uint32_t maximo(uint32_t no)
+{
+    if (no == NULO)
+        return NULO;
+    while (pool.nos[no].direita != NULO)
+        no = pool.nos[no].direita;
+    return no;
+}
+
+// Função para obter o próximo nó em ordem, usando os índices dos pais (NULO depois do último)
+// Percorrer a árvore inteira com sucessor visita cada aresta duas vezes, então o custo é O(1) amortizado
+uint32_t sucessor(uint32_t no)
+{
+    if (pool.nos[no].direita != NULO)
+        return minimo(pool.nos[no].direita);
+    uint32_t noPai = pai(no);
+    while (noPai != NULO && no == pool.nos[noPai].direita)
+    {
+        no = noPai;
+        noPai = pai(noPai);
+    }
+    return noPai;
+}
+
+// Função para obter o nó anterior em ordem (NULO antes do primeiro)
+uint32_t predecessor(uint32_t no)
+{
+    if (pool.nos[no].esquerda != NULO)
+        return maximo(pool.nos[no].esquerda);
+    uint32_t noPai = pai(no);
+    while (noPai != NULO && no == pool.nos[noPai].esquerda)
+    {
+        no = noPai;
+        noPai = pai(noPai);
+    }
+    return noPai;
+}
+
+// Função para encontrar o primeiro nó com valor >= valor (NULO se não houver)
+uint32_t limiteInferior(uint32_t raiz, int valor)
+{
+    uint32_t resposta = NULO;
+    while (raiz != NULO)
+    {
+        if (pool.nos[raiz].valor >= valor)
+        {
+            resposta = raiz;
+            raiz = pool.nos[raiz].esquerda;
+        }
+        else
+            raiz = pool.nos[raiz].direita;
+    }
+    return resposta;
+}
+
+// Função para encontrar o primeiro nó com valor > valor (NULO se não houver)
+uint32_t limiteSuperior(uint32_t raiz, int valor)
+{
+    uint32_t resposta = NULO;
+    while (raiz != NULO)
+    {
+        if (pool.nos[raiz].valor > valor)
+        {
+            resposta = raiz;
+            raiz = pool.nos[raiz].esquerda;
+        }
+        else
+            raiz = pool.nos[raiz].direita;
+    }
+    return resposta;
+}
+
+// Função para substituir, no pai de u, o nó u pelo nó v
+void substituirNo(uint32_t *raiz, uint32_t u, uint32_t v)
+{
+    No *nos = pool.nos;
+    uint32_t uPai = pai(u);
+    if (uPai == NULO)
+        *raiz = v;
+    else if (u == nos[uPai].esquerda)
+        nos[uPai].esquerda = v;
+    else
+        nos[uPai].direita = v;
+    if (v != NULO)
+        definirPai(v, uPai);
+}
+
+// Função para corrigir a árvore após a exclusão de um nó preto
+// x é o nó que ficou com um preto a menos; como ele pode ser NULO, o pai dele vem em separado
+void corrigirExclusao(uint32_t *raiz, uint32_t x, uint32_t xPai)
+{
+    No *nos = pool.nos;
+    while (x != *raiz && !ehVermelho(x))
+    {
+        if (x == nos[xPai].esquerda)
+        {
+            uint32_t w = nos[xPai].direita;
+            if (ehVermelho(w))
+            {
+                definirCor(w, PRETO);
+                definirCor(xPai, VERMELHO);
+                rotacaoEsquerda(raiz, xPai);
+                w = nos[xPai].direita;
+            }
+            if (!ehVermelho(nos[w].esquerda) && !ehVermelho(nos[w].direita))
+            {
+                definirCor(w, VERMELHO);
+                x = xPai;
+                xPai = pai(x);
+            }
+            else
+            {
+                if (!ehVermelho(nos[w].direita))
+                {
+                    definirCor(nos[w].esquerda, PRETO);
+                    definirCor(w, VERMELHO);
+                    rotacaoDireita(raiz, w);
+                    w = nos[xPai].direita;
+                }
+                definirCor(w, cor(xPai));
+                definirCor(xPai, PRETO);
+                definirCor(nos[w].direita, PRETO);
+                rotacaoEsquerda(raiz, xPai);
+                x = *raiz;
+            }
+        }
+        else
+        {
+            uint32_t w = nos[xPai].esquerda;
+            if (ehVermelho(w))
+            {
+                definirCor(w, PRETO);
+                definirCor(xPai, VERMELHO);
+                rotacaoDireita(raiz, xPai);
+                w = nos[xPai].esquerda;
+            }
+            if (!ehVermelho(nos[w].direita) && !ehVermelho(nos[w].esquerda))
+            {
+                definirCor(w, VERMELHO);
+                x = xPai;
+                xPai = pai(x);
+            }
+            else
+            {
+                if (!ehVermelho(nos[w].esquerda))
+                {
+                    definirCor(nos[w].direita, PRETO);
+                    definirCor(w, VERMELHO);
+                    rotacaoEsquerda(raiz, w);
+                    w = nos[xPai].esquerda;
+                }
+                definirCor(w, cor(xPai));
+                definirCor(xPai, PRETO);
+                definirCor(nos[w].esquerda, PRETO);
+                rotacaoDireita(raiz, xPai);
+                x = *raiz;
+            }
+        }
+    }
+    if (x != NULO)
+        definirCor(x, PRETO);
+}
+
+// Função para excluir uma ocorrência de um valor; retorna 1 se o valor existia
+int excluir(uint32_t *raiz, int valor)
+{
+    No *nos = pool.nos;
+    uint32_t z = buscar(*raiz, valor);
+    if (z == NULO)
+        return 0;
+
+    uint32_t y = z;
+    int yCorOriginal = cor(y);
+    uint32_t x, xPai;
+
+#ifdef ESTATISTICA_ORDEM
+    // Todos os ancestrais da posição que perde um nó (a de z, ou a do sucessor se z tem dois filhos)
+    // ficam com um nó a menos; as rotações da correção recalculam os tamanhos que mexerem
+    uint32_t removido = nos[z].esquerda != NULO && nos[z].direita != NULO ? minimo(nos[z].direita) : z;
+    for (uint32_t p = pai(removido); p != NULO; p = pai(p))
+        nos[p].tamanho--;
+#endif
+
+    if (nos[z].esquerda == NULO)
+    {
+        x = nos[z].direita;
+        xPai = pai(z);
+        substituirNo(raiz, z, nos[z].direita);
+    }
+    else if (nos[z].direita == NULO)
+    {
+        x = nos[z].esquerda;
+        xPai = pai(z);
+        substituirNo(raiz, z, nos[z].esquerda);
+    }
+    else
+    {
+        // Dois filhos: o sucessor y ocupa o lugar de z e herda a sua cor
+        y = minimo(nos[z].direita);
+        yCorOriginal = cor(y);
+        x = nos[y].direita;
+        if (pai(y) == z)
+            xPai = y;
+        else
+        {
+            xPai = pai(y);
+            substituirNo(raiz, y, nos[y].direita);
+            nos[y].direita = nos[z].direita;
+            definirPai(nos[y].direita, y);
+        }
+        substituirNo(raiz, z, y);
+        nos[y].esquerda = nos[z].esquerda;
+        definirPai(nos[y].esquerda, y);
+        definirCor(y, cor(z));
+#ifdef ESTATISTICA_ORDEM
+        nos[y].tamanho = nos[z].tamanho; // y ocupa o lugar de z, com a mesma subárvore
+#endif
+    }
+
+    liberarNo(z);
+
+    if (yCorOriginal == PRETO)
+        corrigirExclusao(raiz, x, xPai);
+    return 1;
+}
+
+#ifdef ESTATISTICA_ORDEM
+// Função para encontrar o k-ésimo menor valor (k começando em 0); retorna NULO se k >= tamanho
+uint32_t selecionar(uint32_t raiz, uint32_t k)
+{
+    No *nos = pool.nos;
+    while (raiz != NULO)
+    {
+        uint32_t menores = nos[nos[raiz].esquerda].tamanho;
+        if (k == menores)
+            return raiz;
+        if (k < menores)
+            raiz = nos[raiz].esquerda;
+        else
+        {
+            k -= menores + 1;
+            raiz = nos[raiz].direita;
+        }
+    }
+    return NULO;
+}
+
+// Função para calcular o posto de um valor: quantos valores da árvore são menores que ele
+uint32_t posto(uint32_t raiz, int valor)
+{
+    No *nos = pool.nos;
+    uint32_t menores = 0;
+    while (raiz != NULO)
+    {
+        if (nos[raiz].valor < valor)
+        {
+            menores += nos[nos[raiz].esquerda].tamanho + 1;
+            raiz = nos[raiz].direita;
+        }
+        else
+            raiz = nos[raiz].esquerda;
+    }
+    return menores;
+}
+
+// Função para contar quantos valores estão no intervalo [minimo, maximo]
+uint32_t contarIntervalo(uint32_t raiz, int minimo, int maximo)
+{
+    if (minimo > maximo)
+        return 0;
+    uint32_t ateMaximo = maximo == INT_MAX ? tamanho(raiz) : posto(raiz, maximo + 1);
+    return ateMaximo - posto(raiz, minimo);
+}
+#endif
+
 // Função para imprimir a árvore Red-Black em ordem
-void emOrdem(No *raiz)
+void emOrdem(uint32_t raiz)
 {
-    if (raiz != NULL)
+    if (raiz != NULO)
     {
-        emOrdem(raiz->esquerda);
-        if (raiz->cor == 0)
-            printf("%d RED", raiz->valor);
+        emOrdem(pool.nos[raiz].esquerda);
+        if (cor(raiz) == 0)
+            printf("%d RED", pool.nos[raiz].valor);
         else
-            printf("%d BLK", raiz->valor);
-        emOrdem(raiz->direita);
+            printf("%d BLK", pool.nos[raiz].valor);
+        emOrdem(pool.nos[raiz].direita);
     }
 }
 
 // Função para imprimir a árvore de acordo com o formato esquerda-raiz-direita segundo Sedgewick
-void imprimeArvoreRB(No *raiz, int b)
+void imprimeArvoreRB(uint32_t raiz, int b)
 {
-    if (raiz != NULL)
+    if (raiz != NULO)
     {
         // Chama a função recursivamente para percorrer a subárvore direita
-        imprimeArvoreRB(raiz->direita, b + 1);
+        imprimeArvoreRB(pool.nos[raiz].direita, b + 1);
 
         // Imprime o valor do nó atual com um espaçamento proporcional à sua profundidade
         for (int i = 0; i < b; i++)
             printf("       "); // espaços por nível
-        if (raiz->cor == 0)
-            printf("\033[31m%d\033[0m\n\n", raiz->valor);
+        if (cor(raiz) == 0)
+            printf("\033[31m%d\033[0m\n\n", pool.nos[raiz].valor);
         else
-            printf("%d\n\n", raiz->valor);
+            printf("%d\n\n", pool.nos[raiz].valor);
 
         // Chama a função recursivamente para percorrer a subárvore esquerda
-        imprimeArvoreRB(raiz->esquerda, b + 1);
+        imprimeArvoreRB(pool.nos[raiz].esquerda, b + 1);
+    }
+}
+
+// Função para percorrer a árvore em ordem recursivamente, chamando visitar em cada nó
+void percorrerEmOrdem(uint32_t raiz, void (*visitar)(uint32_t, void *), void *contexto)
+{
+    if (raiz != NULO)
+    {
+        percorrerEmOrdem(pool.nos[raiz].esquerda, visitar, contexto);
+        visitar(raiz, contexto);
+        percorrerEmOrdem(pool.nos[raiz].direita, visitar, contexto);
+    }
+}
+
+// Função para devolver todos os nós de uma árvore à lista livre
+void liberarArvore(uint32_t raiz)
+{
+    if (raiz == NULO)
+        return;
+    liberarArvore(pool.nos[raiz].esquerda);
+    liberarArvore(pool.nos[raiz].direita);
+    liberarNo(raiz);
+}
+
+// Função para liberar o vetor de nós inteiro (todas as árvores) de uma vez
+void destruirPool()
+{
+    free(pool.nos);
+    pool.nos = NULL;
+    pool.usados = pool.capacidade = 0;
+    pool.livre = NULO;
+}
+
+// Retorna o tempo atual em segundos, usado nos benchmarks
+double tempoAtual()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Função usada pelo benchmark para acumular os valores visitados
+void somarValor(uint32_t no, void *contexto)
+{
+    *(long long *)contexto += pool.nos[no].valor;
+}
+
+// Benchmark: percorrer a árvore em ordem pela recursão e pelo iterador sucessor/predecessor
+// Os valores são inseridos em ordem aleatória, então os nós vizinhos em ordem ficam espalhados na memória
+void benchmarkIteracao(int n, int repeticoes)
+{
+    uint32_t raiz = NULO;
+    srand(42);
+    for (int i = 0; i < n; i++)
+        inserir(&raiz, (int)(((unsigned)rand() << 16) ^ (unsigned)rand()));
+
+    long long somaRecursiva = 0, somaSucessor = 0, somaPredecessor = 0;
+    double inicio = tempoAtual();
+    for (int r = 0; r < repeticoes; r++)
+        percorrerEmOrdem(raiz, somarValor, &somaRecursiva);
+    double tempoRecursivo = tempoAtual() - inicio;
+
+    inicio = tempoAtual();
+    for (int r = 0; r < repeticoes; r++)
+        for (uint32_t no = minimo(raiz); no != NULO; no = sucessor(no))
+            somaSucessor += pool.nos[no].valor;
+    double tempoSucessor = tempoAtual() - inicio;
+
+    inicio = tempoAtual();
+    for (int r = 0; r < repeticoes; r++)
+        for (uint32_t no = maximo(raiz); no != NULO; no = predecessor(no))
+            somaPredecessor += pool.nos[no].valor;
+    double tempoPredecessor = tempoAtual() - inicio;
+
+    double visitas = (double)n * repeticoes;
+    printf("%d nos, %d percursos (%s)\n", n, repeticoes,
+           somaRecursiva == somaSucessor && somaSucessor == somaPredecessor ? "somas iguais" : "SOMAS DIFERENTES");
+    printf("Recursivo (percorrerEmOrdem): %6.2f ns/no\n", tempoRecursivo / visitas * 1e9);
+    printf("Iterador sucessor:            %6.2f ns/no\n", tempoSucessor / visitas * 1e9);
+    printf("Iterador predecessor:         %6.2f ns/no\n", tempoPredecessor / visitas * 1e9);
+    destruirPool();
+}
+
+#ifdef ESTATISTICA_ORDEM
+// Estado usado pelo percurso em ordem do benchmark de estatística de ordem
+typedef struct
+{
+    long long k;
+    int minimo, maximo;
+    uint32_t encontrado;
+    uint32_t quantidade;
+} ConsultaLinear;
+
+void visitarSelecao(uint32_t no, void *contexto)
+{
+    ConsultaLinear *c = (ConsultaLinear *)contexto;
+    if (c->k-- == 0)
+        c->encontrado = no;
+}
+
+void visitarContagem(uint32_t no, void *contexto)
+{
+    ConsultaLinear *c = (ConsultaLinear *)contexto;
+    if (pool.nos[no].valor >= c->minimo && pool.nos[no].valor <= c->maximo)
+        c->quantidade++;
+}
+
+// Benchmark: consultas de ordem (k-ésimo, contagem em intervalo) em O(log n)
+// comparadas com o percurso em ordem em O(n)
+void benchmarkEstatistica(int n, int consultas)
+{
+    uint32_t raiz = NULO;
+    srand(11);
+    for (int i = 0; i < n; i++)
+        inserir(&raiz, rand());
+    printf("%u chaves, %d consultas\n", tamanho(raiz), consultas);
+
+    int consultasLineares = consultas < 100 ? consultas : 100;
+    long long somaLog = 0, somaLinear = 0, conferir = 0;
+    uint32_t *ks = (uint32_t *)malloc((size_t)consultas * sizeof(uint32_t));
+    int *limites = (int *)malloc((size_t)consultas * 2 * sizeof(int));
+    if (ks == NULL || limites == NULL)
+    {
+        printf("Erro: Falha ao alocar memória para as consultas.\n");
+        exit(-1);
+    }
+    for (int i = 0; i < consultas; i++)
+    {
+        ks[i] = (uint32_t)rand() % tamanho(raiz);
+        int a = rand(), b = rand();
+        limites[2 * i] = a < b ? a : b;
+        limites[2 * i + 1] = a < b ? b : a;
+    }
+
+    double inicio = tempoAtual();
+    for (int i = 0; i < consultas; i++)
+        somaLog += pool.nos[selecionar(raiz, ks[i])].valor;
+    double tSelecionar = tempoAtual() - inicio;
+    inicio = tempoAtual();
+    for (int i = 0; i < consultasLineares; i++)
+    {
+        ConsultaLinear c = {ks[i], 0, 0, NULO, 0};
+        percorrerEmOrdem(raiz, visitarSelecao, &c);
+        somaLinear += pool.nos[c.encontrado].valor;
+    }
+    double tSelecionarLinear = tempoAtual() - inicio;
+    for (int i = 0; i < consultasLineares; i++)
+        conferir += pool.nos[selecionar(raiz, ks[i])].valor;
+    printf("selecionar      : %10.1f ns/consulta | percurso em ordem: %12.1f ns/consulta (%s)\n",
+           tSelecionar / consultas * 1e9, tSelecionarLinear / consultasLineares * 1e9,
+           conferir == somaLinear ? "iguais" : "DIFERENTES");
+
+    long long contagemLog = 0, contagemLinear = 0;
+    conferir = 0;
+    inicio = tempoAtual();
+    for (int i = 0; i < consultas; i++)
+        contagemLog += contarIntervalo(raiz, limites[2 * i], limites[2 * i + 1]);
+    double tContar = tempoAtual() - inicio;
+    inicio = tempoAtual();
+    for (int i = 0; i < consultasLineares; i++)
+    {
+        ConsultaLinear c = {0, limites[2 * i], limites[2 * i + 1], NULO, 0};
+        percorrerEmOrdem(raiz, visitarContagem, &c);
+        contagemLinear += c.quantidade;
+    }
+    double tContarLinear = tempoAtual() - inicio;
+    for (int i = 0; i < consultasLineares; i++)
+        conferir += contarIntervalo(raiz, limites[2 * i], limites[2 * i + 1]);
+    printf("contarIntervalo : %10.1f ns/consulta | percurso em ordem: %12.1f ns/consulta (%s)\n",
+           tContar / consultas * 1e9, tContarLinear / consultasLineares * 1e9,
+           conferir == contagemLinear ? "iguais" : "DIFERENTES");
+    printf("(somas de controle: %lld %lld)\n", somaLog, contagemLog);
+
+    free(ks);
+    free(limites);
+    destruirPool();
+}
+#endif
+
+// Função para abrir um contador de falhas de cache (perf_event_open) para o próprio processo
+// Retorna -1 se o sistema não oferecer o contador (máquina virtual, perf_event_paranoid alto etc.)
+int abrirContadorFalhas()
+{
+    struct perf_event_attr atributos;
+    memset(&atributos, 0, sizeof(atributos));
+    atributos.size = sizeof(atributos);
+    atributos.type = PERF_TYPE_HARDWARE;
+    atributos.config = PERF_COUNT_HW_CACHE_MISSES;
+    atributos.disabled = 1;
+    atributos.exclude_kernel = 1;
+    atributos.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &atributos, 0, -1, -1, 0);
+}
+
+// Funções para zerar/ligar o contador e para ler o valor acumulado
+void iniciarContador(int contador)
+{
+    if (contador < 0)
+        return;
+    ioctl(contador, PERF_EVENT_IOC_RESET, 0);
+    ioctl(contador, PERF_EVENT_IOC_ENABLE, 0);
+}
+
+long long lerContador(int contador)
+{
+    long long valor = -1;
+    if (contador < 0)
+        return -1;
+    ioctl(contador, PERF_EVENT_IOC_DISABLE, 0);
+    if (read(contador, &valor, sizeof(valor)) != sizeof(valor))
+        return -1;
+    return valor;
+}
+
+// Função auxiliar para imprimir uma linha do benchmark de layout
+void imprimirMedida(const char *operacao, int n, double segundos, long long falhas)
+{
+    printf("%-8s %7.1f ns/op", operacao, segundos / n * 1e9);
+    if (falhas >= 0)
+        printf(", %6.2f falhas de cache/op", (double)falhas / n);
+    printf("\n");
+}
+
+// Benchmark do layout compacto: tempo e falhas de cache por operação para inserir n chaves
+// aleatórias e depois buscar n chaves presentes em ordem aleatória
+void benchmarkLayout(int n)
+{
+    int *chaves = (int *)malloc((size_t)n * sizeof(int));
+    if (chaves == NULL)
+    {
+        printf("Erro: Falha ao alocar memória para as chaves.\n");
+        exit(-1);
+    }
+    uint64_t estado = 88172645463325252ull;
+    for (int i = 0; i < n; i++)
+    {
+        estado ^= estado << 13;
+        estado ^= estado >> 7;
+        estado ^= estado << 17;
+        chaves[i] = (int)(estado >> 33);
     }
+
+    int contador = abrirContadorFalhas();
+    printf("Layout: %zu bytes por no, %d chaves\n", sizeof(No), n);
+    if (contador < 0)
+        printf("Contador de falhas de cache indisponivel (perf_event_open); medindo apenas o tempo\n");
+
+    uint32_t raiz = NULO;
+    reservarNos((uint32_t)n + 1);
+    iniciarContador(contador);
+    double inicio = tempoAtual();
+    for (int i = 0; i < n; i++)
+        inserir(&raiz, chaves[i]);
+    double tempo = tempoAtual() - inicio;
+    imprimirMedida("Insercao", n, tempo, lerContador(contador));
+
+    // Busca as mesmas chaves em outra ordem aleatória
+    for (int i = n - 1; i > 0; i--)
+    {
+        estado ^= estado << 13;
+        estado ^= estado >> 7;
+        estado ^= estado << 17;
+        int j = (int)(estado % (uint64_t)(i + 1));
+        int temp = chaves[i];
+        chaves[i] = chaves[j];
+        chaves[j] = temp;
+    }
+    long long encontradas = 0;
+    iniciarContador(contador);
+    inicio = tempoAtual();
+    for (int i = 0; i < n; i++)
+        encontradas += buscar(raiz, chaves[i]) != NULO;
+    tempo = tempoAtual() - inicio;
+    imprimirMedida("Busca", n, tempo, lerContador(contador));
+    printf("%lld chaves encontradas\n", encontradas);
+
+    if (contador >= 0)
+        close(contador);
+    free(chaves);
+    destruirPool();
 }
 
-int main()
+// Função principal
+// Uso: RedBlack [bench [n] [repeticoes]]
+//      RedBlack layout [n]
+//      RedBlack ordem [n] [consultas]  (compilado com -DESTATISTICA_ORDEM)
+int main(int argc, char *argv[])
 {
-    struct No *raiz = NULL;
+    if (argc > 1 && strcmp(argv[1], "bench") == 0)
+    {
+        benchmarkIteracao(argc > 2 ? atoi(argv[2]) : 1000000, argc > 3 ? atoi(argv[3]) : 10);
+        return 0;
+    }
+    if (argc > 1 && strcmp(argv[1], "layout") == 0)
+    {
+        benchmarkLayout(argc > 2 ? atoi(argv[2]) : 50000000);
+        return 0;
+    }
+#ifdef ESTATISTICA_ORDEM
+    if (argc > 1 && strcmp(argv[1], "ordem") == 0)
+    {
+        benchmarkEstatistica(argc > 2 ? atoi(argv[2]) : 1000000, argc > 3 ? atoi(argv[3]) : 1000000);
+        return 0;
+    }
+#endif
+
+    uint32_t raiz = NULO;
     // Exemplo de inserção de valores na árvore Red-Black
     int vetor[] = {12, 31, 20, 17, 11, 8, 3, 24, 15, 33};
     int i, tam = sizeof(vetor) / sizeof(vetor[0]);
@@ -187,5 +983,26 @@ int main()
     imprimeArvoreRB(raiz, 3);
     printf("\n");
 
+    // Consultas e iteração sem imprimir a árvore
+    printf("Busca por 24: %s\n", buscar(raiz, 24) != NULO ? "encontrado" : "não encontrado");
+    uint32_t limite = limiteInferior(raiz, 16);
+    printf("Primeiro valor >= 16: %d\n", limite != NULO ? pool.nos[limite].valor : -1);
+    limite = limiteSuperior(raiz, 17);
+    printf("Primeiro valor > 17: %d\n", limite != NULO ? pool.nos[limite].valor : -1);
+    printf("Valores entre 10 e 25:");
+    for (uint32_t no = limiteInferior(raiz, 10); no != NULO && pool.nos[no].valor <= 25; no = sucessor(no))
+        printf(" %d", pool.nos[no].valor);
+    printf("\n");
+#ifdef ESTATISTICA_ORDEM
+    printf("Mediana: %d | posto de 20: %u | valores em [10, 25]: %u\n",
+           pool.nos[selecionar(raiz, tamanho(raiz) / 2)].valor, posto(raiz, 20), contarIntervalo(raiz, 10, 25));
+#endif
+
+    printf("Excluindo a raiz %d\nÁrvore Red-Black: \n", pool.nos[raiz].valor);
+    excluir(&raiz, pool.nos[raiz].valor);
+    imprimeArvoreRB(raiz, 3);
+    printf("\n");
+
+    destruirPool();
     return 0;
 }
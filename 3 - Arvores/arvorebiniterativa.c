@@ -1,5 +1,12 @@
 #include <stdio.h>   // Inclui a biblioteca padrão de entrada e saída
 #include <stdlib.h>  // Inclui a biblioteca padrão de alocação de memória
+#include <string.h>  // Inclui strcmp
+#include <time.h>    // Inclui clock_gettime, usado no benchmark
+#include <unistd.h>  // Inclui sysconf, para descobrir o tamanho da cache
+#include "Arena.h"   // Inclui o alocador de nós em slabs
+#include "ArvoreEstatica.h"  // Inclui os layouts estáticos Eytzinger e van Emde Boas
+#include "BuscaEmLote.h"  // Inclui a busca em lote intercalada
+
 
 // Estrutura de um nó da árvore binária
 typedef struct NoArvore {
@@ -14,9 +21,9 @@ typedef struct Pilha {
     struct Pilha* topo;   // Ponteiro para o próximo elemento da pilha
 } Pilha;
 
-// Função para criar um novo nó
-NoArvore* criarNo(int dado) {
-    NoArvore* novoNo = (NoArvore*)malloc(sizeof(NoArvore));  // Aloca memória para um novo nó
+// Função para criar um novo nó na arena da árvore (se a arena for NULL, usa malloc)
+NoArvore* criarNo(int dado, Arena* arena) {
+    NoArvore* novoNo = (NoArvore*)alocarNo(arena, sizeof(NoArvore));  // Aloca memória para um novo nó
     if (novoNo == NULL) {  // Verifica se a alocação foi bem-sucedida
         printf("Erro: Falha na alocação de memória.\n");
         return NULL;  // Retorna NULL em caso de falha
@@ -28,18 +35,18 @@ NoArvore* criarNo(int dado) {
 }
 
 // Função para inserir elementos na árvore balanceada a partir de um vetor ordenado
-NoArvore* inserirElementos(int vetor[], int inicio, int fim) {
+NoArvore* inserirElementos(int vetor[], int inicio, int fim, Arena* arena) {
     if (inicio > fim)  // Caso base: se a sublista é inválida, retorna NULL
         return NULL;
 
     int meio = (inicio + fim) / 2;           // Calcula o índice do meio do vetor
-    NoArvore* novoNo = criarNo(vetor[meio]); // Cria um nó com o valor do meio
+    NoArvore* novoNo = criarNo(vetor[meio], arena); // Cria um nó com o valor do meio
 
     // Insere recursivamente os elementos na subárvore esquerda
-    novoNo->esquerda = inserirElementos(vetor, inicio, meio - 1);
+    novoNo->esquerda = inserirElementos(vetor, inicio, meio - 1, arena);
     
     // Insere recursivamente os elementos na subárvore direita
-    novoNo->direita = inserirElementos(vetor, meio + 1, fim);
+    novoNo->direita = inserirElementos(vetor, meio + 1, fim, arena);
     
     return novoNo;  // Retorna o ponteiro para o nó criado
 }
@@ -58,6 +65,21 @@ NoArvore* buscarElemento(NoArvore* raiz, int dado) {
     }
 }
 
+// Passo de buscarEmLote: termina no nó com o dado (ou em NULL) ou desce para o filho do lado dele
+#define PASSO_ARVORE(no, procurado, etapa, terminou) do {                \
+        if (no == NULL || no->dado == procurado) {  /* Busca terminada */  \
+            terminou = 1;                                                   \
+        } else {                                                            \
+            no = procurado < no->dado ? no->esquerda : no->direita;         \
+        }                                                                   \
+    } while (0)
+
+// Função para buscar n elementos de uma vez; saida[i] recebe o nó de chaves[i] ou NULL
+// As buscas descem intercaladas para sobrepor as faltas de cache (veja BuscaEmLote.h)
+void buscarEmLote(NoArvore* raiz, const int chaves[], int n, NoArvore* saida[]) {
+    BUSCA_EM_LOTE(NoArvore, raiz, chaves, n, saida, PASSO_ARVORE);
+}
+
 // Função para encontrar o menor valor em uma subárvore
 struct NoArvore *encontrarMinimo(struct NoArvore *raiz)
 {
@@ -71,7 +93,7 @@ struct NoArvore *encontrarMinimo(struct NoArvore *raiz)
 }
 
 // Função para excluir um nó da árvore
-struct NoArvore *excluir(struct NoArvore *raiz, int dado)
+struct NoArvore *excluir(struct NoArvore *raiz, int dado, Arena *arena)
 {
     if (raiz == NULL)  // Se a árvore estiver vazia, retorna NULL
     {
@@ -80,11 +102,11 @@ struct NoArvore *excluir(struct NoArvore *raiz, int dado)
 
     if (dado < raiz->dado)  // Se o valor for menor, exclui na subárvore esquerda
     {
-        raiz->esquerda = excluir(raiz->esquerda, dado);
+        raiz->esquerda = excluir(raiz->esquerda, dado, arena);
     }
     else if (dado > raiz->dado)  // Se o valor for maior, exclui na subárvore direita
     {
-        raiz->direita = excluir(raiz->direita, dado);
+        raiz->direita = excluir(raiz->direita, dado, arena);
     }
     else  // Se o nó a ser excluído for encontrado
     {
@@ -92,24 +114,57 @@ struct NoArvore *excluir(struct NoArvore *raiz, int dado)
         if (raiz->esquerda == NULL)
         {
             struct NoArvore *temp = raiz->direita;  // Armazena o filho direito
-            free(raiz);  // Libera a memória do nó atual
+            liberarNo(arena, raiz);  // Libera a memória do nó atual
             return temp;  // Retorna o filho direito
         }
         else if (raiz->direita == NULL)
         {
             struct NoArvore *temp = raiz->esquerda;  // Armazena o filho esquerdo
-            free(raiz);  // Libera a memória do nó atual
+            liberarNo(arena, raiz);  // Libera a memória do nó atual
             return temp;  // Retorna o filho esquerdo
         }
 
         // Caso 2: Nó com dois filhos, encontra o sucessor in-order (menor valor na subárvore direita)
         struct NoArvore *temp = encontrarMinimo(raiz->direita);  // Encontra o menor valor na subárvore direita
         raiz->dado = temp->dado;  // Substitui o valor do nó a ser excluído pelo sucessor
-        raiz->direita = excluir(raiz->direita, temp->dado);  // Exclui o sucessor in-order
+        raiz->direita = excluir(raiz->direita, temp->dado, arena);  // Exclui o sucessor in-order
     }
     return raiz;  // Retorna a nova raiz da subárvore
 }
 
+// Função auxiliar para copiar as chaves da árvore em ordem para um vetor
+void copiarEmOrdem(NoArvore* raiz, int vetor[], int* posicao) {
+    if (raiz != NULL) {
+        copiarEmOrdem(raiz->esquerda, vetor, posicao);
+        vetor[(*posicao)++] = raiz->dado;
+        copiarEmOrdem(raiz->direita, vetor, posicao);
+    }
+}
+
+// Função para contar os nós da árvore
+int contarNos(NoArvore* raiz) {
+    if (raiz == NULL) {
+        return 0;
+    }
+    return 1 + contarNos(raiz->esquerda) + contarNos(raiz->direita);
+}
+
+// Função para congelar a árvore: copia as chaves para um vetor sem ponteiros no layout pedido
+// (LAYOUT_EYTZINGER ou LAYOUT_VEB). A árvore original continua válida e pode ser liberada
+ArvoreEstatica* congelarArvore(NoArvore* raiz, int layout) {
+    int n = contarNos(raiz);
+    int* ordenado = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    if (ordenado == NULL) {
+        printf("Erro: Falha na alocação de memória.\n");
+        exit(-1);
+    }
+    int posicao = 0;
+    copiarEmOrdem(raiz, ordenado, &posicao);
+    ArvoreEstatica* estatica = congelar(ordenado, n, layout);
+    free(ordenado);
+    return estatica;
+}
+
 // Função para push um nó
 void push(Pilha** topo, NoArvore* no) {
     Pilha* novaPilha = (Pilha*)malloc(sizeof(Pilha));  // Aloca memória para um novo elemento da pilha
@@ -229,13 +284,119 @@ void posOrdemIt(NoArvore* raiz) {
     }
 }
 
+// Função para liberar os nós da árvore
+// Uma arena usada só por esta árvore (arenaExclusiva) é esvaziada de uma vez; se ela for
+// dividida com outras árvores, os nós desta voltam um a um para a lista livre
+void liberarArvore(NoArvore* raiz, Arena* arena, int arenaExclusiva) {
+    if (arena != NULL && arenaExclusiva) {
+        arenaEsvaziar(arena);
+        return;
+    }
+    if (raiz != NULL) {
+        liberarArvore(raiz->esquerda, arena, 0);
+        liberarArvore(raiz->direita, arena, 0);
+        liberarNo(arena, raiz);
+    }
+}
+
+// Retorna o tempo atual em segundos, usado no benchmark
+double tempoAtual() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Benchmark: latência de busca na árvore de ponteiros (uma a uma e em lote) e nas versões
+// congeladas Eytzinger e van Emde Boas, com as chaves ocupando de 16 KiB (cabe na L1) até 10x a LLC
+void benchmarkEstatica(int buscas) {
+    long llc = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    if (llc <= 0) {
+        llc = 32L << 20;  // Valor usado quando o sistema não informa a LLC
+    }
+    // Cada chave ocupa ~24 vezes o seu tamanho somando o nó com ponteiros, as cópias congeladas
+    // e os vetores temporários, então o maior tamanho também fica limitado pela memória física
+    long limite = 10 * llc;
+    long memoria = sysconf(_SC_PHYS_PAGES) * sysconf(_SC_PAGESIZE);
+    if (memoria > 0 && limite > memoria / 24) {
+        limite = memoria / 24;
+    }
+    printf("LLC: %ld KiB, maior teste: %ld KiB de chaves, %d buscas por tamanho (metade presentes)\n",
+           llc >> 10, limite >> 10, buscas);
+    printf("%10s %12s %12s %12s %12s %12s\n", "chaves", "KiB chaves", "ponteiros", "em lote", "Eytzinger", "vEB");
+
+    int* consultas = (int*)malloc(buscas * sizeof(int));
+    NoArvore** saida = (NoArvore**)malloc(buscas * sizeof(NoArvore*));
+    for (long bytes = 16L << 10; bytes <= limite; bytes *= 4) {
+        int n = (int)(bytes / sizeof(int));
+        int* vetor = (int*)malloc(n * sizeof(int));
+        for (int i = 0; i < n; i++) {
+            vetor[i] = 2 * i;  // Chaves pares; as consultas ímpares não são encontradas
+        }
+        NoArvore* raiz = inserirElementos(vetor, 0, n - 1, NULL);
+        ArvoreEstatica* eytzinger = congelarArvore(raiz, LAYOUT_EYTZINGER);
+        ArvoreEstatica* veb = congelarArvore(raiz, LAYOUT_VEB);
+        srand(n);
+        for (int i = 0; i < buscas; i++) {
+            consultas[i] = (int)((((unsigned)rand() << 16) ^ (unsigned)rand()) % (unsigned)(2 * n));
+        }
+
+        long long encontradas[4] = {0, 0, 0, 0};
+        double tempos[4];
+        double inicio = tempoAtual();
+        for (int i = 0; i < buscas; i++) {
+            encontradas[0] += buscarElemento(raiz, consultas[i]) != NULL;
+        }
+        tempos[0] = tempoAtual() - inicio;
+
+        inicio = tempoAtual();
+        buscarEmLote(raiz, consultas, buscas, saida);
+        tempos[1] = tempoAtual() - inicio;
+        for (int i = 0; i < buscas; i++) {
+            encontradas[1] += saida[i] != NULL;
+        }
+
+        inicio = tempoAtual();
+        for (int i = 0; i < buscas; i++) {
+            encontradas[2] += estaticaContem(eytzinger, consultas[i]);
+        }
+        tempos[2] = tempoAtual() - inicio;
+
+        inicio = tempoAtual();
+        for (int i = 0; i < buscas; i++) {
+            encontradas[3] += estaticaContem(veb, consultas[i]);
+        }
+        tempos[3] = tempoAtual() - inicio;
+
+        printf("%10d %12ld", n, bytes >> 10);
+        for (int v = 0; v < 4; v++) {
+            printf(" %9.1f ns", tempos[v] / buscas * 1e9);
+        }
+        printf("%s\n", encontradas[1] == encontradas[0] && encontradas[2] == encontradas[0] &&
+                           encontradas[3] == encontradas[0] ? "" : "  RESULTADOS DIFERENTES");
+
+        liberarEstatica(eytzinger);
+        liberarEstatica(veb);
+        liberarArvore(raiz, NULL, 0);
+        free(vetor);
+    }
+    free(consultas);
+    free(saida);
+}
+
 // Função principal para testar o código
-int main() {
+// Uso: arvorebiniterativa [bench [buscas]]
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+        benchmarkEstatica(argc > 2 ? atoi(argv[2]) : 2000000);
+        return 0;
+    }
+
     int vetor[] = {1, 2, 3, 4, 5, 6, 7};  // Vetor ordenado de entrada
     int n = sizeof(vetor) / sizeof(vetor[0]);  // Calcula o tamanho do vetor
     
-    // Cria uma árvore balanceada a partir do vetor ordenado
-    NoArvore* raiz = inserirElementos(vetor, 0, n - 1);
+    // Cria uma árvore balanceada a partir do vetor ordenado, com os nós na arena dela
+    Arena* arena = criarArena(sizeof(NoArvore));
+    NoArvore* raiz = inserirElementos(vetor, 0, n - 1, arena);
     
     // Testa as funções de travessia recursiva
     printf("Travessia Pré-Ordem Recursiva: ");
@@ -263,5 +424,33 @@ int main() {
     posOrdemIt(raiz);
     printf("\n");
 
+    // Testa a busca em lote
+    int procurados[] = {4, 9, 1, 7, 0};
+    NoArvore* encontrados[5];
+    buscarEmLote(raiz, procurados, 5, encontrados);
+    printf("Busca em lote:");
+    for (int i = 0; i < 5; i++) {
+        printf(" %d%s", procurados[i], encontrados[i] != NULL ? "(sim)" : "(nao)");
+    }
+    printf("\n");
+
+    // Congela a árvore nos dois layouts estáticos
+    ArvoreEstatica* eytzinger = congelarArvore(raiz, LAYOUT_EYTZINGER);
+    ArvoreEstatica* veb = congelarArvore(raiz, LAYOUT_VEB);
+    printf("Eytzinger:");
+    for (int i = 1; i <= eytzinger->n; i++) {
+        printf(" %d", eytzinger->chaves[i]);
+    }
+    printf("\nvan Emde Boas:");
+    for (int i = 0; i < (1 << veb->altura) - 1; i++) {
+        printf(" %d", veb->chaves[i]);
+    }
+    printf("\nBusca estatica: 5 %s, 8 %s\n", estaticaContem(veb, 5) ? "(sim)" : "(nao)",
+           estaticaContem(eytzinger, 8) ? "(sim)" : "(nao)");
+    liberarEstatica(eytzinger);
+    liberarEstatica(veb);
+    liberarArvore(raiz, arena, 1);
+    destruirArena(arena);
+
     return 0;  // Finaliza o programa
 }
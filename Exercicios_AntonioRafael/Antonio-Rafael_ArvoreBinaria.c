@@ -1,5 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include "../3 - Arvores/BuscaEmLote.h"
+
 
 // Estrutura do nó da árvore binária
 typedef struct No{
@@ -97,6 +99,21 @@ No *procuraNo(No *raiz, int dados) {
     return procuraNo(raiz->direita, dados);
 }
 
+// Passo de procuraEmLote: termina no nó com o valor (ou em NULL) ou desce para o filho do lado dele
+#define PASSO_PROCURA(no, valor, etapa, terminou) do {            \
+        if (no == NULL || no->dados == valor) {                    \
+            terminou = 1;                                          \
+        } else {                                                   \
+            no = valor < no->dados ? no->esquerda : no->direita;   \
+        }                                                          \
+    } while (0)
+
+// Função para pesquisar n elementos de uma vez; saida[i] recebe o nó de dados[i] ou NULL
+// As pesquisas descem intercaladas para sobrepor as faltas de cache (veja BuscaEmLote.h)
+void procuraEmLote(No *raiz, const int dados[], int n, No *saida[]) {
+    BUSCA_EM_LOTE(No, raiz, dados, n, saida, PASSO_PROCURA);
+}
+
 // Função para imprimir a árvore binária
 void imprimeArvore(No *raiz, int level) {
     if (raiz == NULL) {
@@ -151,6 +168,16 @@ int main() {
     printf("Arvore Montada:\n");
     imprimeArvore(raiz, 0);
 
+    // Pesquisa vários valores de uma vez
+    int procurados[] = {10, 30, 40, 70, 80};
+    No *encontrados[5];
+    procuraEmLote(raiz, procurados, 5, encontrados);
+    printf("\nPesquisa em lote:");
+    for (int i = 0; i < 5; i++) {
+        printf(" %d%s", procurados[i], encontrados[i] != NULL ? "(sim)" : "(nao)");
+    }
+    printf("\n");
+
     valorParaExcluir = 30;
     if (procuraNo(raiz, valorParaExcluir) != NULL) {
       printf("\nDeletar valor: %d\n", valorParaExcluir);
@@ -0,0 +1,359 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// B+-tree: todas as chaves ficam nas folhas, que são ligadas entre si da esquerda para a direita.
+// Os nós internos guardam apenas separadores (cópias de chaves) para guiar a descida.
+// Uma consulta de intervalo [lo, hi) é uma descida até a folha de lo seguida de uma
+// caminhada sequencial pelas folhas, feita pela API de cursor.
+
+#define MIN_DEGREE 3
+
+// Estrutura de um nó da B+-tree
+struct BPlusNode {
+    int *chaves;
+    int num_chaves;
+    struct BPlusNode **filhos;  // Usado apenas nos nós internos
+    struct BPlusNode *proximo;  // Próxima folha (apenas nas folhas)
+    int grau;
+    int folha;
+};
+
+// Cursor para percorrer as chaves em ordem a partir de uma posição
+typedef struct {
+    struct BPlusNode *folha;  // Folha atual (NULL quando o cursor terminou)
+    int posicao;              // Índice da próxima chave dentro da folha
+} Cursor;
+
+// Função para criar um novo nó da B+-tree
+struct BPlusNode* criarNo(int grau, int folha) {
+    struct BPlusNode* novo_no = (struct BPlusNode*)malloc(sizeof(struct BPlusNode));
+    novo_no->grau = grau;
+    novo_no->folha = folha;
+    novo_no->chaves = (int*)malloc((2 * grau - 1) * sizeof(int));
+    novo_no->filhos = folha ? NULL : (struct BPlusNode**)malloc(2 * grau * sizeof(struct BPlusNode*));
+    novo_no->proximo = NULL;
+    novo_no->num_chaves = 0;
+    return novo_no;
+}
+
+// Função auxiliar para dividir um filho cheio
+// Folha: a metade direita vai para o novo nó e a primeira chave dela é copiada para o pai.
+// Nó interno: igual à B-tree, a chave do meio sobe para o pai.
+void dividirFilho(struct BPlusNode *pai, int i) {
+    int grau = pai->grau;
+    struct BPlusNode *filho = pai->filhos[i];
+    struct BPlusNode *novo_no = criarNo(grau, filho->folha);
+    int separador;
+
+    if (filho->folha) {
+        // O filho fica com grau-1 chaves e o novo nó com as grau restantes
+        novo_no->num_chaves = grau;
+        memcpy(novo_no->chaves, filho->chaves + grau - 1, grau * sizeof(int));
+        filho->num_chaves = grau - 1;
+        separador = novo_no->chaves[0];
+
+        // Encadeia o novo nó na lista de folhas
+        novo_no->proximo = filho->proximo;
+        filho->proximo = novo_no;
+    } else {
+        novo_no->num_chaves = grau - 1;
+        memcpy(novo_no->chaves, filho->chaves + grau, (grau - 1) * sizeof(int));
+        memcpy(novo_no->filhos, filho->filhos + grau, grau * sizeof(struct BPlusNode*));
+        filho->num_chaves = grau - 1;
+        separador = filho->chaves[grau - 1];
+    }
+
+    // Move os filhos e as chaves do pai para abrir espaço para o novo nó
+    memmove(pai->filhos + i + 2, pai->filhos + i + 1, (pai->num_chaves - i) * sizeof(struct BPlusNode*));
+    pai->filhos[i + 1] = novo_no;
+    memmove(pai->chaves + i + 1, pai->chaves + i, (pai->num_chaves - i) * sizeof(int));
+    pai->chaves[i] = separador;
+    pai->num_chaves++;
+}
+
+// Função para inserir em um nó não cheio (descida iterativa)
+void inserirNaoCheio(struct BPlusNode *no, int chave) {
+    while (!no->folha) {
+        // Desce pelo primeiro filho cujo separador é maior que a chave
+        int i = no->num_chaves;
+        while (i > 0 && no->chaves[i - 1] > chave) {
+            i--;
+        }
+        if (no->filhos[i]->num_chaves == 2 * no->grau - 1) {
+            dividirFilho(no, i);
+            if (no->chaves[i] <= chave) {
+                i++;
+            }
+        }
+        no = no->filhos[i];
+    }
+
+    int i = no->num_chaves - 1;
+    while (i >= 0 && no->chaves[i] > chave) {
+        no->chaves[i + 1] = no->chaves[i];
+        i--;
+    }
+    no->chaves[i + 1] = chave;
+    no->num_chaves++;
+}
+
+// Função para inserir uma chave na B+-tree
+void inserir(struct BPlusNode **raiz, int chave) {
+    struct BPlusNode *r = *raiz;
+
+    if (r->num_chaves == 2 * r->grau - 1) {
+        struct BPlusNode *novo_no = criarNo(r->grau, 0);
+        novo_no->filhos[0] = r;
+        dividirFilho(novo_no, 0);
+        *raiz = novo_no;
+    }
+    inserirNaoCheio(*raiz, chave);
+}
+
+// Função para descer até a folha onde estaria a primeira chave >= chave
+// Retorna a folha e, em *posicao, o índice dessa chave dentro dela
+struct BPlusNode* descerAteFolha(struct BPlusNode *no, int chave, int *posicao) {
+    while (!no->folha) {
+        int i = 0;
+        while (i < no->num_chaves && no->chaves[i] < chave) {
+            i++;
+        }
+        no = no->filhos[i];
+    }
+    int i = 0;
+    while (i < no->num_chaves && no->chaves[i] < chave) {
+        i++;
+    }
+    *posicao = i;
+    return no;
+}
+
+// Função para buscar uma chave na B+-tree; retorna a folha que a contém ou NULL
+struct BPlusNode* buscar(struct BPlusNode *raiz, int chave) {
+    int i;
+    struct BPlusNode *folha = descerAteFolha(raiz, chave, &i);
+    // Chaves iguais ao separador podem ter ficado na folha seguinte
+    while (folha != NULL && i == folha->num_chaves) {
+        folha = folha->proximo;
+        i = 0;
+    }
+    if (folha != NULL && folha->chaves[i] == chave) {
+        return folha;  // Chave encontrada
+    }
+    return NULL;  // Chave não encontrada
+}
+
+// seek: posiciona o cursor na primeira chave >= lo
+void cursorPosicionar(Cursor *cursor, struct BPlusNode *raiz, int lo) {
+    cursor->folha = descerAteFolha(raiz, lo, &cursor->posicao);
+}
+
+// next: coloca a próxima chave em *chave e avança; retorna 0 quando não há mais chaves
+int cursorProximo(Cursor *cursor, int *chave) {
+    while (cursor->folha != NULL && cursor->posicao == cursor->folha->num_chaves) {
+        cursor->folha = cursor->folha->proximo;
+        cursor->posicao = 0;
+    }
+    if (cursor->folha == NULL) {
+        return 0;
+    }
+    *chave = cursor->folha->chaves[cursor->posicao++];
+    return 1;
+}
+
+// batchNext: copia até n chaves seguintes para buffer e retorna quantas foram copiadas
+// Copia trechos inteiros de cada folha com memcpy, sem testar chave a chave
+int cursorProximosLote(Cursor *cursor, int buffer[], int n) {
+    int copiadas = 0;
+    while (copiadas < n && cursor->folha != NULL) {
+        int disponiveis = cursor->folha->num_chaves - cursor->posicao;
+        if (disponiveis == 0) {
+            cursor->folha = cursor->folha->proximo;
+            cursor->posicao = 0;
+            continue;
+        }
+        if (disponiveis > n - copiadas) {
+            disponiveis = n - copiadas;
+        }
+        memcpy(buffer + copiadas, cursor->folha->chaves + cursor->posicao, disponiveis * sizeof(int));
+        cursor->posicao += disponiveis;
+        copiadas += disponiveis;
+    }
+    return copiadas;
+}
+
+// Função para imprimir a B+-tree em ordem, caminhando pelas folhas ligadas
+void imprimirEmOrdem(struct BPlusNode *raiz) {
+    Cursor cursor;
+    int chave;
+    cursorPosicionar(&cursor, raiz, -2147483647 - 1);
+    while (cursorProximo(&cursor, &chave)) {
+        printf("%d ", chave);
+    }
+}
+
+// Função para imprimir as chaves do intervalo [lo, hi)
+void imprimirIntervalo(struct BPlusNode *raiz, int lo, int hi) {
+    Cursor cursor;
+    int chave;
+    cursorPosicionar(&cursor, raiz, lo);
+    while (cursorProximo(&cursor, &chave) && chave < hi) {
+        printf("%d ", chave);
+    }
+}
+
+// Função para liberar a memória
+void liberarBPlusTree(struct BPlusNode* no) {
+    if (no != NULL) {
+        if (!no->folha) {
+            for (int i = 0; i <= no->num_chaves; i++) {
+                liberarBPlusTree(no->filhos[i]);
+            }
+        }
+        free(no->chaves);
+        free(no->filhos);
+        free(no);
+    }
+}
+
+// Retorna o tempo atual em segundos, usado no benchmark
+double tempoAtual() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Soma das chaves em [lo, hi) por travessia recursiva de todos os nós, como imprimirEmOrdem da B-tree
+long long somarIntervaloRecursivo(struct BPlusNode *no, int lo, int hi) {
+    long long soma = 0;
+    if (no->folha) {
+        for (int i = 0; i < no->num_chaves; i++) {
+            if (no->chaves[i] >= lo && no->chaves[i] < hi) {
+                soma += no->chaves[i];
+            }
+        }
+        return soma;
+    }
+    for (int i = 0; i <= no->num_chaves; i++) {
+        soma += somarIntervaloRecursivo(no->filhos[i], lo, hi);
+    }
+    return soma;
+}
+
+// Soma das chaves em [lo, hi) com o cursor: uma descida e leitura das folhas em lotes
+long long somarIntervaloCursor(struct BPlusNode *raiz, int lo, int hi) {
+    Cursor cursor;
+    int buffer[256];
+    long long soma = 0;
+    int n;
+    cursorPosicionar(&cursor, raiz, lo);
+    while ((n = cursorProximosLote(&cursor, buffer, 256)) > 0) {
+        for (int i = 0; i < n; i++) {
+            if (buffer[i] >= hi) {
+                return soma;
+            }
+            soma += buffer[i];
+        }
+    }
+    return soma;
+}
+
+// Benchmark: consultas de intervalo [lo, lo + largura) com o cursor e com a travessia recursiva
+void benchmark(int n, int consultas, int largura, int grau) {
+    struct BPlusNode *raiz = criarNo(grau, 1);
+    srand(42);
+    for (int i = 0; i < n; i++) {
+        inserir(&raiz, rand() % (4 * n));
+    }
+
+    int *inicios = (int*)malloc(consultas * sizeof(int));
+    for (int q = 0; q < consultas; q++) {
+        inicios[q] = rand() % (4 * n);
+    }
+
+    long long somaCursor = 0, somaRecursiva = 0;
+    double inicio = tempoAtual();
+    for (int q = 0; q < consultas; q++) {
+        somaCursor += somarIntervaloCursor(raiz, inicios[q], inicios[q] + largura);
+    }
+    double tCursor = tempoAtual() - inicio;
+
+    // A travessia recursiva é muito mais lenta, então roda só uma fração das consultas
+    int consultasRecursivas = consultas < 20 ? consultas : 20;
+    inicio = tempoAtual();
+    for (int q = 0; q < consultasRecursivas; q++) {
+        somaRecursiva += somarIntervaloRecursivo(raiz, inicios[q], inicios[q] + largura);
+    }
+    double tRecursiva = tempoAtual() - inicio;
+
+    long long conferencia = 0;
+    for (int q = 0; q < consultasRecursivas; q++) {
+        conferencia += somarIntervaloCursor(raiz, inicios[q], inicios[q] + largura);
+    }
+
+    printf("%d chaves, grau %d, intervalos de largura %d\n", n, grau, largura);
+    printf("cursor   : %10.2f us por consulta\n", tCursor / consultas * 1e6);
+    printf("recursiva: %10.2f us por consulta (%s)\n", tRecursiva / consultasRecursivas * 1e6,
+           conferencia == somaRecursiva ? "mesmo resultado" : "RESULTADO DIFERENTE");
+    printf("ganho    : %10.1fx\n", (tRecursiva / consultasRecursivas) / (tCursor / consultas));
+    (void)somaCursor;
+    free(inicios);
+    liberarBPlusTree(raiz);
+}
+
+// Função principal
+// Uso: AntonioRafael_BPlusTree [bench [n] [consultas] [largura] [grau]]
+int main(int argc, char *argv[]) {
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+        int n = argc > 2 ? atoi(argv[2]) : 1000000;
+        int consultas = argc > 3 ? atoi(argv[3]) : 100000;
+        int largura = argc > 4 ? atoi(argv[4]) : 1000;
+        int grau = argc > 5 ? atoi(argv[5]) : 32;
+        benchmark(n, consultas, largura, grau);
+        return 0;
+    }
+
+    int grau = MIN_DEGREE;
+    struct BPlusNode* raiz = criarNo(grau, 1);
+
+    // Inserindo algumas chaves para teste
+    int chaves[] = {10, 20, 5, 6, 12, 30, 25, 7, 17, 3, 28, 15};
+    for (int i = 0; i < (int)(sizeof(chaves) / sizeof(chaves[0])); i++) {
+        inserir(&raiz, chaves[i]);
+    }
+
+    printf("Impressao da B+-tree em ordem (pelas folhas):\n");
+    imprimirEmOrdem(raiz);
+    printf("\n");
+
+    printf("Chaves no intervalo [6, 20):\n");
+    imprimirIntervalo(raiz, 6, 20);
+    printf("\n");
+
+    // Leitura em lotes de 4 chaves com o cursor
+    Cursor cursor;
+    int lote[4], n;
+    cursorPosicionar(&cursor, raiz, 0);
+    printf("Lotes de 4 chaves:\n");
+    while ((n = cursorProximosLote(&cursor, lote, 4)) > 0) {
+        for (int i = 0; i < n; i++) {
+            printf("%d ", lote[i]);
+        }
+        printf("| ");
+    }
+    printf("\n");
+
+    // Teste de busca
+    int chave_busca = 12;
+    if (buscar(raiz, chave_busca)) {
+        printf("Chave %d encontrada na B+-tree.\n", chave_busca);
+    } else {
+        printf("Chave %d não encontrada na B+-tree.\n", chave_busca);
+    }
+
+    // Liberar memória
+    liberarBPlusTree(raiz);
+    return 0;
+}
@@ -1,12 +1,23 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <limits.h>
+#include <immintrin.h>
+#include "../3 - Arvores/OrdenacaoParalela.h"
+#include "../3 - Arvores/BuscaEmLote.h"
 
 #define MIN_DEGREE 3
 #define MAX_DEGREE 7
+#define LIMIAR_BUSCA_BINARIA 128  // A partir desse número de chaves no nó, usa a busca binária sem desvios
+#define MAX_LAPIDES 4096           // Lápides pendentes antes de a exclusão preguiçosa começar a compactar
+#define LAPIDES_POR_PASSO 2        // Lápides removidas fisicamente a cada exclusão preguiçosa acima do limite
+#define LINHAS_PREFETCH 8          // Linhas de cache do vetor de chaves pedidas antes de buscar no nó
 
 // Estrutura de um nó da B-tree
 struct BTreeNode {
     int *chaves;
+    unsigned char *apagadas;  // Marca de lápide de cada chave (exclusão preguiçosa)
     int num_chaves;
     struct BTreeNode **filhos;
     int grau;
@@ -19,11 +30,107 @@ struct BTreeNode* criarNo(int grau, int folha) {
     novo_no->grau = grau;
     novo_no->folha = folha;
     novo_no->chaves = (int*)malloc((2 * grau - 1) * sizeof(int));
+    novo_no->apagadas = (unsigned char*)calloc(2 * grau - 1, sizeof(unsigned char));
     novo_no->filhos = (struct BTreeNode**)malloc(2 * grau * sizeof(struct BTreeNode*));
     novo_no->num_chaves = 0;
     return novo_no;
 }
 
+// Busca dentro do nó: retorna quantas chaves do vetor ordenado são menores que a chave procurada
+// Há versões escalar, SSE4 e AVX2 (comparam 4 ou 8 chaves de uma vez) e uma binária sem desvios
+int limiteInferiorEscalar(const int *chaves, int n, int chave) {
+    int i = 0;
+    while (i < n && chave > chaves[i]) {
+        i++;
+    }
+    return i;
+}
+
+// As versões vetoriais contam as chaves menores em todos os blocos, sem sair do laço mais cedo:
+// o número de iterações depende só do tamanho do nó, então não há desvio difícil de prever
+__attribute__((target("sse4.1")))
+int limiteInferiorSSE(const int *chaves, int n, int chave) {
+    __m128i procurada = _mm_set1_epi32(chave);
+    __m128i contagem = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i bloco = _mm_loadu_si128((const __m128i*)(chaves + i));
+        contagem = _mm_sub_epi32(contagem, _mm_cmpgt_epi32(procurada, bloco));  // Cada chave menor soma 1
+    }
+    contagem = _mm_add_epi32(contagem, _mm_shuffle_epi32(contagem, 0x4E));
+    contagem = _mm_add_epi32(contagem, _mm_shuffle_epi32(contagem, 0xB1));
+    int total = _mm_cvtsi128_si32(contagem);
+    for (; i < n; i++) {
+        total += chaves[i] < chave;
+    }
+    return total;
+}
+
+__attribute__((target("avx2")))
+int limiteInferiorAVX2(const int *chaves, int n, int chave) {
+    __m256i procurada = _mm256_set1_epi32(chave);
+    __m256i contagem = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i bloco = _mm256_loadu_si256((const __m256i*)(chaves + i));
+        contagem = _mm256_sub_epi32(contagem, _mm256_cmpgt_epi32(procurada, bloco));
+    }
+    __m128i soma = _mm_add_epi32(_mm256_castsi256_si128(contagem), _mm256_extracti128_si256(contagem, 1));
+    soma = _mm_add_epi32(soma, _mm_shuffle_epi32(soma, 0x4E));
+    soma = _mm_add_epi32(soma, _mm_shuffle_epi32(soma, 0xB1));
+    int total = _mm_cvtsi128_si32(soma);
+    for (; i < n; i++) {
+        total += chaves[i] < chave;
+    }
+    return total;
+}
+
+// Busca binária sem desvios: o laço sempre executa log2(n) passos e a escolha vira um cmov
+int limiteInferiorBinario(const int *chaves, int n, int chave) {
+    if (n == 0) {
+        return 0;
+    }
+    const int *base = chaves;
+    while (n > 1) {
+        int metade = n / 2;
+        base = (base[metade] < chave) ? base + metade : base;
+        n -= metade;
+    }
+    return (int)(base - chaves) + (*base < chave);
+}
+
+// Versão vetorial escolhida na primeira chamada, de acordo com o processador
+int escolherLimiteInferior(const int *chaves, int n, int chave);
+int (*limiteInferiorVetorial)(const int*, int, int) = escolherLimiteInferior;
+
+int escolherLimiteInferior(const int *chaves, int n, int chave) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        limiteInferiorVetorial = limiteInferiorAVX2;
+    } else if (__builtin_cpu_supports("sse4.1")) {
+        limiteInferiorVetorial = limiteInferiorSSE;
+    } else {
+        limiteInferiorVetorial = limiteInferiorEscalar;
+    }
+    return limiteInferiorVetorial(chaves, n, chave);
+}
+
+// Retorna a posição da primeira chave do nó >= chave
+int limiteInferior(struct BTreeNode *no, int chave) {
+    if (no->num_chaves >= LIMIAR_BUSCA_BINARIA) {
+        return limiteInferiorBinario(no->chaves, no->num_chaves, chave);
+    }
+    return limiteInferiorVetorial(no->chaves, no->num_chaves, chave);
+}
+
+// Retorna a posição da primeira chave do nó > chave
+int limiteSuperior(struct BTreeNode *no, int chave) {
+    if (chave == INT_MAX) {
+        return no->num_chaves;
+    }
+    return limiteInferior(no, chave + 1);
+}
+
 // Função auxiliar para dividir um filho cheio
 void dividirFilho(struct BTreeNode *pai, int i) {
     int grau = pai->grau;
@@ -34,6 +141,7 @@ void dividirFilho(struct BTreeNode *pai, int i) {
     // Move as últimas chaves do filho para o novo nó
     for (int j = 0; j < grau - 1; j++) {
         novo_no->chaves[j] = filho->chaves[j + grau];
+        novo_no->apagadas[j] = filho->apagadas[j + grau];
     }
     if (!filho->folha) {
         for (int j = 0; j < grau; j++) {
@@ -51,27 +159,25 @@ void dividirFilho(struct BTreeNode *pai, int i) {
     // Move as chaves do pai
     for (int j = pai->num_chaves - 1; j >= i; j--) {
         pai->chaves[j + 1] = pai->chaves[j];
+        pai->apagadas[j + 1] = pai->apagadas[j];
     }
     pai->chaves[i] = filho->chaves[grau - 1];
+    pai->apagadas[i] = filho->apagadas[grau - 1];
     pai->num_chaves++;
 }
 
 // Função para inserir em um nó não cheio
 void inserirNaoCheio(struct BTreeNode *no, int chave) {
-    int i = no->num_chaves - 1;
+    // Posição logo após as chaves menores ou iguais
+    int i = limiteSuperior(no, chave);
 
     if (no->folha) {
-        while (i >= 0 && no->chaves[i] > chave) {
-            no->chaves[i + 1] = no->chaves[i];
-            i--;
-        }
-        no->chaves[i + 1] = chave;
+        memmove(no->chaves + i + 1, no->chaves + i, (no->num_chaves - i) * sizeof(int));
+        memmove(no->apagadas + i + 1, no->apagadas + i, no->num_chaves - i);
+        no->chaves[i] = chave;
+        no->apagadas[i] = 0;
         no->num_chaves++;
     } else {
-        while (i >= 0 && no->chaves[i] > chave) {
-            i--;
-        }
-        i++;
         if (no->filhos[i]->num_chaves == 2 * no->grau - 1) {
             dividirFilho(no, i);
             if (no->chaves[i] < chave) {
@@ -101,19 +207,395 @@ void inserir(struct BTreeNode **raiz, int chave) {
     }
 }
 
-// Função para buscar uma chave na B-tree
+// Função para buscar uma ocorrência da chave com a marca de lápide indicada
+// Como a B-tree aceita chaves repetidas, as ocorrências podem estar no nó e nos filhos i..j
+// que ficam entre as chaves iguais. Retorna o nó e, em *posicao, o índice da chave
+struct BTreeNode* buscarEntrada(struct BTreeNode* no, int chave, int apagada, int *posicao) {
+    int i = limiteInferior(no, chave);
+    int j = i;
+    for (; j < no->num_chaves && no->chaves[j] == chave; j++) {
+        if (no->apagadas[j] == apagada) {
+            *posicao = j;
+            return no;
+        }
+    }
+    if (no->folha) {
+        return NULL;
+    }
+    for (int k = i; k <= j; k++) {
+        struct BTreeNode *resultado = buscarEntrada(no->filhos[k], chave, apagada, posicao);
+        if (resultado != NULL) {
+            return resultado;
+        }
+    }
+    return NULL;
+}
+
+// Função para buscar uma chave na B-tree (ignora as chaves com lápide)
 struct BTreeNode* buscar(struct BTreeNode* no, int chave) {
-    int i = 0;
-    while (i < no->num_chaves && chave > no->chaves[i]) {
-        i++;
+    int posicao;
+    return buscarEntrada(no, chave, 0, &posicao);
+}
+
+// Passo de buscarEmLote. Em cada nível há duas leituras dependentes: o nó e depois o vetor de chaves
+// dele, então cada nível leva duas etapas, e ao fim de cada uma a busca passa a vez para as outras:
+//   etapa 0: o nó chegou; pede as primeiras linhas do vetor de chaves
+//   etapa 1: as chaves chegaram; busca no nó e desce para o filho escolhido
+// Se a chave existe no nó mas com lápide, termina com buscar a partir dele (chaves repetidas)
+#define PASSO_BTREE(no, procurada, etapa, terminou) do {                          \
+        if (etapa == 0) {                                                          \
+            int bytes = no->num_chaves * (int)sizeof(int);                         \
+            for (int b = 0; b < bytes && b < LINHAS_PREFETCH * 64; b += 64) {      \
+                __builtin_prefetch((const char*)no->chaves + b);                   \
+            }                                                                      \
+            etapa = 1;                                                             \
+        } else {                                                                   \
+            int i = limiteInferior(no, procurada);                                 \
+            if (i < no->num_chaves && no->chaves[i] == procurada) {                \
+                no = no->apagadas[i] ? buscar(no, procurada) : no;                 \
+                terminou = 1;                                                      \
+            } else if (no->folha) {                                                \
+                no = NULL;                                                         \
+                terminou = 1;                                                      \
+            } else {                                                               \
+                no = no->filhos[i];                                                \
+                etapa = 0;                                                         \
+            }                                                                      \
+        }                                                                          \
+    } while (0)
+
+// Função para buscar n chaves de uma vez; saida[i] recebe o nó de chaves[i] ou NULL (como buscar)
+// As buscas descem intercaladas para sobrepor as faltas de cache (veja BuscaEmLote.h)
+void buscarEmLote(struct BTreeNode* raiz, const int chaves[], int n, struct BTreeNode* saida[]) {
+    BUSCA_EM_LOTE(struct BTreeNode, raiz, chaves, n, saida, PASSO_BTREE);
+}
+
+// Copia a chave orig->chaves[j] (com a sua marca de lápide) para dest->chaves[i]
+void copiarChave(struct BTreeNode *dest, int i, struct BTreeNode *orig, int j) {
+    dest->chaves[i] = orig->chaves[j];
+    dest->apagadas[i] = orig->apagadas[j];
+}
+
+// Remove a chave i de um nó, deslocando as chaves (e filhos à direita dela) seguintes
+void removerPosicao(struct BTreeNode *no, int i) {
+    memmove(no->chaves + i, no->chaves + i + 1, (no->num_chaves - i - 1) * sizeof(int));
+    memmove(no->apagadas + i, no->apagadas + i + 1, no->num_chaves - i - 1);
+    if (!no->folha) {
+        memmove(no->filhos + i + 1, no->filhos + i + 2, (no->num_chaves - i - 1) * sizeof(struct BTreeNode*));
+    }
+    no->num_chaves--;
+}
+
+// Junta filhos[i], a chave i do pai e filhos[i+1] em um único nó (filhos[i])
+void juntarFilhos(struct BTreeNode *pai, int i) {
+    struct BTreeNode *esquerdo = pai->filhos[i];
+    struct BTreeNode *direito = pai->filhos[i + 1];
+    int n = esquerdo->num_chaves;
+
+    copiarChave(esquerdo, n, pai, i);
+    for (int j = 0; j < direito->num_chaves; j++) {
+        copiarChave(esquerdo, n + 1 + j, direito, j);
+    }
+    if (!esquerdo->folha) {
+        for (int j = 0; j <= direito->num_chaves; j++) {
+            esquerdo->filhos[n + 1 + j] = direito->filhos[j];
+        }
     }
+    esquerdo->num_chaves += direito->num_chaves + 1;
+    removerPosicao(pai, i);
+
+    free(direito->chaves);
+    free(direito->apagadas);
+    free(direito->filhos);
+    free(direito);
+}
+
+// Empresta uma chave do irmão à esquerda de filhos[i], passando pelo pai
+void emprestarDaEsquerda(struct BTreeNode *pai, int i) {
+    struct BTreeNode *filho = pai->filhos[i];
+    struct BTreeNode *irmao = pai->filhos[i - 1];
+
+    memmove(filho->chaves + 1, filho->chaves, filho->num_chaves * sizeof(int));
+    memmove(filho->apagadas + 1, filho->apagadas, filho->num_chaves);
+    if (!filho->folha) {
+        memmove(filho->filhos + 1, filho->filhos, (filho->num_chaves + 1) * sizeof(struct BTreeNode*));
+        filho->filhos[0] = irmao->filhos[irmao->num_chaves];
+    }
+    copiarChave(filho, 0, pai, i - 1);
+    copiarChave(pai, i - 1, irmao, irmao->num_chaves - 1);
+    filho->num_chaves++;
+    irmao->num_chaves--;
+}
+
+// Empresta uma chave do irmão à direita de filhos[i], passando pelo pai
+void emprestarDaDireita(struct BTreeNode *pai, int i) {
+    struct BTreeNode *filho = pai->filhos[i];
+    struct BTreeNode *irmao = pai->filhos[i + 1];
+
+    copiarChave(filho, filho->num_chaves, pai, i);
+    if (!filho->folha) {
+        filho->filhos[filho->num_chaves + 1] = irmao->filhos[0];
+        memmove(irmao->filhos, irmao->filhos + 1, irmao->num_chaves * sizeof(struct BTreeNode*));
+    }
+    copiarChave(pai, i, irmao, 0);
+    memmove(irmao->chaves, irmao->chaves + 1, (irmao->num_chaves - 1) * sizeof(int));
+    memmove(irmao->apagadas, irmao->apagadas + 1, irmao->num_chaves - 1);
+    filho->num_chaves++;
+    irmao->num_chaves--;
+}
+
+// Garante que filhos[i] tenha pelo menos grau chaves antes de descer nele
+// Retorna o índice do filho onde a descida deve continuar (muda quando junta com o irmão à esquerda)
+int preencherFilho(struct BTreeNode *pai, int i) {
+    int grau = pai->grau;
+    if (i > 0 && pai->filhos[i - 1]->num_chaves >= grau) {
+        emprestarDaEsquerda(pai, i);
+    } else if (i < pai->num_chaves && pai->filhos[i + 1]->num_chaves >= grau) {
+        emprestarDaDireita(pai, i);
+    } else if (i < pai->num_chaves) {
+        juntarFilhos(pai, i);
+    } else {
+        juntarFilhos(pai, i - 1);
+        i--;
+    }
+    return i;
+}
+
+int removerDaSubarvore(struct BTreeNode *no, int chave);
+
+// Remove da subárvore a ocorrência (chave, apagada) que acabou de ser copiada para o pai
+// Se a remoção tirou outra ocorrência da mesma chave com marca diferente, troca as marcas
+void removerEntrada(struct BTreeNode *no, int chave, int apagada) {
+    int removida = removerDaSubarvore(no, chave);
+    if (removida != apagada) {
+        int posicao;
+        struct BTreeNode *outro = buscarEntrada(no, chave, apagada, &posicao);
+        outro->apagadas[posicao] = removida;
+    }
+}
+
+// Remove fisicamente uma ocorrência da chave, com empréstimo e junção de nós na descida
+// Antes de descer em um filho, garante que ele tenha pelo menos grau chaves (exclusão em uma passada)
+// Retorna a marca de lápide da ocorrência removida, ou -1 se a chave não existir
+int removerDaSubarvore(struct BTreeNode *no, int chave) {
+    int grau = no->grau;
+    int i = limiteInferior(no, chave);
+
     if (i < no->num_chaves && no->chaves[i] == chave) {
-        return no;  // Chave encontrada
+        int apagada = no->apagadas[i];
+        if (no->folha) {
+            // Caso 1: chave em uma folha
+            removerPosicao(no, i);
+            return apagada;
+        }
+        struct BTreeNode *esquerdo = no->filhos[i];
+        struct BTreeNode *direito = no->filhos[i + 1];
+        if (esquerdo->num_chaves >= grau) {
+            // Caso 2a: substitui pelo predecessor e o remove da subárvore esquerda
+            struct BTreeNode *p = esquerdo;
+            while (!p->folha) {
+                p = p->filhos[p->num_chaves];
+            }
+            copiarChave(no, i, p, p->num_chaves - 1);
+            removerEntrada(esquerdo, no->chaves[i], no->apagadas[i]);
+        } else if (direito->num_chaves >= grau) {
+            // Caso 2b: substitui pelo sucessor e o remove da subárvore direita
+            struct BTreeNode *s = direito;
+            while (!s->folha) {
+                s = s->filhos[0];
+            }
+            copiarChave(no, i, s, 0);
+            removerEntrada(direito, no->chaves[i], no->apagadas[i]);
+        } else {
+            // Caso 2c: junta os dois filhos com a chave e remove do nó resultante
+            juntarFilhos(no, i);
+            return removerDaSubarvore(esquerdo, chave);
+        }
+        return apagada;
     }
+
     if (no->folha) {
-        return NULL;  // Chave não encontrada
+        return -1;  // Chave não encontrada
+    }
+    // Caso 3: a chave está na subárvore filhos[i]
+    if (no->filhos[i]->num_chaves < grau) {
+        i = preencherFilho(no, i);
     }
-    return buscar(no->filhos[i], chave);
+    return removerDaSubarvore(no->filhos[i], chave);
+}
+
+// Se a raiz ficou sem chaves, o único filho passa a ser a raiz (a árvore diminui de altura)
+void reduzirRaiz(struct BTreeNode **raiz) {
+    struct BTreeNode *r = *raiz;
+    if (r->num_chaves == 0 && !r->folha) {
+        *raiz = r->filhos[0];
+        free(r->chaves);
+        free(r->apagadas);
+        free(r->filhos);
+        free(r);
+    }
+}
+
+// Função para excluir uma ocorrência da chave da B-tree; retorna 1 se a chave existia
+int excluir(struct BTreeNode **raiz, int chave) {
+    if (buscar(*raiz, chave) == NULL) {
+        return 0;
+    }
+    if (removerDaSubarvore(*raiz, chave) == 1) {
+        // Saiu uma lápide da mesma chave no lugar da ocorrência viva: a viva vira a lápide
+        int posicao;
+        struct BTreeNode *no = buscarEntrada(*raiz, chave, 0, &posicao);
+        no->apagadas[posicao] = 1;
+    }
+    reduzirRaiz(raiz);
+    return 1;
+}
+
+// B-tree com a sua fila de lápides ainda não removidas fisicamente (uma entrada por lápide)
+// A fila fica junto da raiz: compactar uma árvore só pode remover chaves dela
+struct BTree {
+    struct BTreeNode *raiz;
+    int *lapidesPendentes;
+    int numLapides;
+    int capacidadeLapides;
+};
+
+// Inicia a árvore com a raiz dada e sem lápides pendentes
+void iniciarBTree(struct BTree *arvore, struct BTreeNode *raiz) {
+    arvore->raiz = raiz;
+    arvore->lapidesPendentes = NULL;
+    arvore->numLapides = 0;
+    arvore->capacidadeLapides = 0;
+}
+
+// Remove fisicamente uma ocorrência com lápide da chave
+void removerLapide(struct BTree *arvore, int chave) {
+    if (removerDaSubarvore(arvore->raiz, chave) == 0) {
+        // Saiu a ocorrência viva no lugar da lápide: a lápide volta a ser viva
+        int posicao;
+        struct BTreeNode *no = buscarEntrada(arvore->raiz, chave, 1, &posicao);
+        no->apagadas[posicao] = 0;
+    }
+    reduzirRaiz(&arvore->raiz);
+}
+
+// Remove fisicamente até limite lápides pendentes; retorna quantas ainda faltam
+// É a compactação em segundo plano, conduzida por quem usa a árvore: chamada em momentos ociosos,
+// compacta a árvore aos poucos. Não há uma thread própria para isso porque a árvore não tem travas,
+// e uma thread compactando em paralelo obrigaria a travar todas as operações
+int compactarPasso(struct BTree *arvore, int limite) {
+    while (limite-- > 0 && arvore->numLapides > 0) {
+        removerLapide(arvore, arvore->lapidesPendentes[--arvore->numLapides]);
+    }
+    return arvore->numLapides;
+}
+
+// Remove fisicamente todas as lápides pendentes
+void compactar(struct BTree *arvore) {
+    compactarPasso(arvore, arvore->numLapides);
+}
+
+// Exclusão preguiçosa: apenas marca uma ocorrência viva como lápide, sem reorganizar nós
+// Acima de MAX_LAPIDES pendentes, cada exclusão também remove fisicamente LAPIDES_POR_PASSO lápides,
+// o que limita o espaço desperdiçado sem criar picos de latência mesmo se compactarPasso nunca for chamada
+int excluirPreguicoso(struct BTree *arvore, int chave) {
+    int posicao;
+    struct BTreeNode *no = buscarEntrada(arvore->raiz, chave, 0, &posicao);
+    if (no == NULL) {
+        return 0;
+    }
+    no->apagadas[posicao] = 1;
+
+    if (arvore->numLapides == arvore->capacidadeLapides) {
+        int capacidade = arvore->capacidadeLapides ? 2 * arvore->capacidadeLapides : 64;
+        int *lapides = (int*)realloc(arvore->lapidesPendentes, capacidade * sizeof(int));
+        if (lapides == NULL) {
+            // Sem espaço na fila: a lápide é removida na hora (a fila antiga continua válida)
+            removerLapide(arvore, chave);
+            return 1;
+        }
+        arvore->lapidesPendentes = lapides;
+        arvore->capacidadeLapides = capacidade;
+    }
+    arvore->lapidesPendentes[arvore->numLapides++] = chave;
+
+    if (arvore->numLapides > MAX_LAPIDES) {
+        compactarPasso(arvore, LAPIDES_POR_PASSO);
+    }
+    return 1;
+}
+
+// Função para carregar n chaves de uma vez, montando a B-tree de baixo para cima em tempo O(n)
+// preenchimento (0 a 1) é a fração das 2*grau-1 posições ocupada em cada nó; valores menores
+// deixam espaço para inserções futuras sem divisões. Todo nó (exceto a raiz) fica com pelo menos grau-1 chaves.
+// Se o vetor não estiver ordenado, uma cópia é ordenada em paralelo antes da montagem
+struct BTreeNode* carregarEmLote(int vetor[], int n, int grau, double preenchimento) {
+    int maximo = 2 * grau - 1, minimo = grau - 1;
+    int alvo = (int)(preenchimento * maximo + 0.5);
+    if (alvo < minimo) alvo = minimo;
+    if (alvo > maximo) alvo = maximo;
+    if (alvo < 1) alvo = 1;
+
+    if (n == 0) {
+        return criarNo(grau, 1);
+    }
+
+    int *chaves = vetor;
+    if (!estaOrdenado(vetor, n)) {
+        chaves = (int*)malloc((size_t)n * sizeof(int));
+        memcpy(chaves, vetor, (size_t)n * sizeof(int));
+        ordenarParalelo(chaves, n);
+    }
+
+    // Cada nível é montado a partir dos itens (chaves) e dos nós do nível de baixo.
+    // Entre dois nós vizinhos sobe uma chave separadora, que vira item do nível de cima
+    int m = n;
+    int *itens = chaves;
+    struct BTreeNode **filhos = NULL;
+    int folha = 1;
+    struct BTreeNode *raiz = NULL;
+    while (raiz == NULL) {
+        int quantidade = (m + alvo + 1) / (alvo + 1);  // Nós neste nível com o preenchimento desejado
+        while (quantidade > 1 && (m - quantidade + 1) / quantidade < minimo) {
+            quantidade--;  // Evita nós com menos de grau-1 chaves no fim do vetor
+        }
+        int restantes = m - (quantidade - 1);  // Chaves que ficam nos nós (o resto sobe)
+        struct BTreeNode **nos = (struct BTreeNode**)malloc(quantidade * sizeof(struct BTreeNode*));
+        int *separadores = (int*)malloc((quantidade > 1 ? quantidade - 1 : 1) * sizeof(int));
+        int pos = 0, filho = 0;
+
+        for (int k = 0; k < quantidade; k++) {
+            int q = restantes / quantidade + (k < restantes % quantidade);
+            struct BTreeNode *no = criarNo(grau, folha);
+            for (int j = 0; j < q; j++) {
+                no->chaves[j] = itens[pos++];
+            }
+            if (!folha) {
+                for (int j = 0; j <= q; j++) {
+                    no->filhos[j] = filhos[filho++];
+                }
+            }
+            no->num_chaves = q;
+            nos[k] = no;
+            if (k < quantidade - 1) {
+                separadores[k] = itens[pos++];
+            }
+        }
+
+        if (itens != vetor) free(itens);
+        free(filhos);
+        if (quantidade == 1) {
+            raiz = nos[0];
+            free(nos);
+            free(separadores);
+        } else {
+            itens = separadores;
+            m = quantidade - 1;
+            filhos = nos;
+            folha = 0;
+        }
+    }
+    return raiz;
 }
 
 // Função para imprimir a B-tree em ordem
@@ -124,7 +606,9 @@ void imprimirEmOrdem(struct BTreeNode* no) {
             if (!no->folha) {
                 imprimirEmOrdem(no->filhos[i]);
             }
-            printf("%d ", no->chaves[i]);  // Imprimir a chave
+            if (!no->apagadas[i]) {
+                printf("%d ", no->chaves[i]);  // Imprimir a chave (as lápides não aparecem)
+            }
         }
         // Imprimir o último filho
         if (!no->folha) {
@@ -142,39 +626,211 @@ void liberarBTree(struct BTreeNode* no) {
             }
         }
         free(no->chaves);
+        free(no->apagadas);
         free(no->filhos);
         free(no);
     }
 }
 
+// Libera os nós e a fila de lápides da árvore
+void liberarArvore(struct BTree *arvore) {
+    liberarBTree(arvore->raiz);
+    free(arvore->lapidesPendentes);
+    iniciarBTree(arvore, NULL);
+}
+
+// Retorna o tempo atual em segundos, usado no benchmark
+double tempoAtual() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Microbenchmark: buscas por segundo dentro de um nó, para cada largura de nó e cada versão
+void benchmarkBuscaNoNo(int buscas) {
+    const char *nomes[] = {"escalar", "SSE4", "AVX2", "binaria"};
+    int (*versoes[])(const int*, int, int) = {limiteInferiorEscalar, limiteInferiorSSE, limiteInferiorAVX2, limiteInferiorBinario};
+    int numVersoes = 4;
+    __builtin_cpu_init();
+    if (!__builtin_cpu_supports("avx2")) {
+        // Sem AVX2 mede só escalar, SSE4 e binária
+        versoes[2] = limiteInferiorBinario;
+        nomes[2] = nomes[3];
+        numVersoes = 3;
+    }
+
+    int *procuradas = (int*)malloc(buscas * sizeof(int));
+    printf("%8s", "chaves");
+    for (int v = 0; v < numVersoes; v++) {
+        printf(" %14s", nomes[v]);
+    }
+    printf("   (milhoes de buscas/s)\n");
+
+    for (int largura = 8; largura <= 2048; largura *= 2) {
+        int *chaves = (int*)malloc(largura * sizeof(int));
+        srand(largura);
+        for (int i = 0; i < largura; i++) {
+            chaves[i] = i * 16 + rand() % 16;  // Vetor ordenado
+        }
+        for (int b = 0; b < buscas; b++) {
+            procuradas[b] = rand() % (largura * 16 + 16);
+        }
+
+        printf("%8d", largura);
+        long long conferencia = -1;
+        for (int v = 0; v < numVersoes; v++) {
+            long long soma = 0;
+            double inicio = tempoAtual();
+            for (int b = 0; b < buscas; b++) {
+                soma += versoes[v](chaves, largura, procuradas[b]);
+            }
+            double tempo = tempoAtual() - inicio;
+            printf(" %14.1f", buscas / tempo / 1e6);
+            if (conferencia >= 0 && soma != conferencia) {
+                printf("(!)");
+            }
+            conferencia = soma;
+        }
+        printf("\n");
+        free(chaves);
+    }
+    free(procuradas);
+}
+
+// Benchmark: buscas por segundo na árvore inteira, uma a uma e em lote, para alguns graus
+void benchmarkBuscaArvore(int n) {
+    int *chaves = (int*)malloc(n * sizeof(int));
+    int *consultas = (int*)malloc(n * sizeof(int));
+    struct BTreeNode **saida = (struct BTreeNode**)malloc(n * sizeof(struct BTreeNode*));
+    srand(42);
+    for (int i = 0; i < n; i++) {
+        chaves[i] = rand();
+    }
+    for (int grau = 4; grau <= 512; grau *= 2) {
+        struct BTreeNode *raiz = criarNo(grau, 1);
+        for (int i = 0; i < n; i++) {
+            inserir(&raiz, chaves[i]);
+        }
+        int encontradas = 0, encontradasLote = 0;
+        double inicio = tempoAtual();
+        for (int i = 0; i < n; i++) {
+            encontradas += buscar(raiz, chaves[(i * 7919L) % n]) != NULL;
+        }
+        double tempo = tempoAtual() - inicio;
+
+        // As mesmas buscas em lote
+        for (int i = 0; i < n; i++) {
+            consultas[i] = chaves[(i * 7919L) % n];
+        }
+        inicio = tempoAtual();
+        buscarEmLote(raiz, consultas, n, saida);
+        double tempoLote = tempoAtual() - inicio;
+        for (int i = 0; i < n; i++) {
+            encontradasLote += saida[i] != NULL;
+        }
+        printf("grau %4d: %6.2f M buscas/s | em lote %6.2f M buscas/s (%d encontradas%s)\n", grau, n / tempo / 1e6,
+               n / tempoLote / 1e6, encontradas, encontradasLote == encontradas ? "" : ", LOTE DIFERENTE");
+        liberarBTree(raiz);
+    }
+    free(chaves);
+    free(consultas);
+    free(saida);
+}
+
+// Função de comparação de latências para o qsort
+int compararTempos(const void *a, const void *b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Benchmark: latência por exclusão (percentis) no modo imediato e no preguiçoso
+void benchmarkExclusao(int n, int grau) {
+    int *chaves = (int*)malloc(n * sizeof(int));
+    double *tempos = (double*)malloc(n * sizeof(double));
+    srand(42);
+    for (int i = 0; i < n; i++) {
+        chaves[i] = rand();
+    }
+
+    for (int modo = 0; modo < 2; modo++) {
+        struct BTree arvore;
+        iniciarBTree(&arvore, carregarEmLote(chaves, n, grau, 0.7));
+        double inicio = tempoAtual();
+        for (int i = 0; i < n; i++) {
+            int chave = chaves[(i * 7919L) % n];
+            double t0 = tempoAtual();
+            if (modo == 0) {
+                excluir(&arvore.raiz, chave);
+            } else {
+                excluirPreguicoso(&arvore, chave);
+            }
+            tempos[i] = tempoAtual() - t0;
+        }
+        double total = tempoAtual() - inicio;
+        int pendentes = arvore.numLapides;
+        compactar(&arvore);
+
+        qsort(tempos, n, sizeof(double), compararTempos);
+        printf("%-10s: %6.2f M exclusoes/s | p50 %6.0f ns | p99 %6.0f ns | p99.9 %6.0f ns | max %8.0f ns | %d lapides pendentes\n",
+               modo ? "preguicosa" : "imediata", n / total / 1e6, tempos[n / 2] * 1e9, tempos[(int)(n * 0.99)] * 1e9,
+               tempos[(int)(n * 0.999)] * 1e9, tempos[n - 1] * 1e9, pendentes);
+        liberarArvore(&arvore);
+    }
+    free(chaves);
+    free(tempos);
+}
+
 // Função principal
-int main() {
+int main(int argc, char *argv[]) {
+    // Executa os benchmarks com "bench [buscas] [n]" em vez da demonstração
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+        benchmarkBuscaNoNo(argc > 2 ? atoi(argv[2]) : 5000000);
+        benchmarkBuscaArvore(argc > 3 ? atoi(argv[3]) : 1000000);
+        benchmarkExclusao(argc > 3 ? atoi(argv[3]) : 1000000, 64);
+        return 0;
+    }
+
     int grau = MIN_DEGREE;
-    struct BTreeNode* raiz = criarNo(grau, 1);
+    struct BTree arvore;
+    iniciarBTree(&arvore, criarNo(grau, 1));
 
     // Inserindo algumas chaves para teste
-    inserir(&raiz, 10);
-    inserir(&raiz, 20);
-    inserir(&raiz, 5);
-    inserir(&raiz, 6);
-    inserir(&raiz, 12);
-    inserir(&raiz, 30);
-    inserir(&raiz, 25);  // Adicionando mais uma chave para ver melhor a estrutura
+    inserir(&arvore.raiz, 10);
+    inserir(&arvore.raiz, 20);
+    inserir(&arvore.raiz, 5);
+    inserir(&arvore.raiz, 6);
+    inserir(&arvore.raiz, 12);
+    inserir(&arvore.raiz, 30);
+    inserir(&arvore.raiz, 25);  // Adicionando mais uma chave para ver melhor a estrutura
 
     printf("Impressao da B-tree em ordem:\n");
-    imprimirEmOrdem(raiz);
+    imprimirEmOrdem(arvore.raiz);
     printf("\n");
 
     // Teste de busca
     int chave_busca = 12;
-    struct BTreeNode* resultado = buscar(raiz, chave_busca);
+    struct BTreeNode* resultado = buscar(arvore.raiz, chave_busca);
     if (resultado) {
         printf("Chave %d encontrada na B-tree.\n", chave_busca);
     } else {
         printf("Chave %d não encontrada na B-tree.\n", chave_busca);
     }
 
+    // Teste de exclusão
+    excluir(&arvore.raiz, 6);
+    excluir(&arvore.raiz, 20);
+    printf("B-tree apos excluir 6 e 20:\n");
+    imprimirEmOrdem(arvore.raiz);
+    printf("\n");
+
+    // Exclusão preguiçosa: a chave some das buscas, mas só sai do nó na compactação
+    excluirPreguicoso(&arvore, 25);
+    printf("B-tree apos excluir 25 (lapide, %d pendente):\n", arvore.numLapides);
+    imprimirEmOrdem(arvore.raiz);
+    printf("\n");
+    compactar(&arvore);
+
     // Liberar memória
-    liberarBTree(raiz);
+    liberarArvore(&arvore);
     return 0;
 }
@@ -0,0 +1,427 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <time.h>
+#include <immintrin.h>
+
+// B-tree concorrente com acoplamento otimista de travas (optimistic lock coupling).
+// Cada nó tem uma versão: o bit 1 indica que o nó está travado para escrita e
+// cada destravamento soma 2, mudando a versão. Leitores nunca escrevem na memória
+// compartilhada: leem a versão, leem o nó e conferem se a versão continua a mesma;
+// se mudou, recomeçam da raiz. Escritores travam apenas os nós que modificam
+// (a folha da inserção, ou o nó cheio e o pai durante uma divisão).
+// Como nesta versão não há exclusão, nenhum nó é liberado enquanto a árvore está em uso.
+// Um leitor pode ler um campo ao mesmo tempo que um escritor o altera (a versão só é conferida
+// depois), então os campos do nó são atômicos e acessados com memory_order_relaxed: a leitura
+// pode vir inconsistente, mas é definida, e a versão descarta o resultado. Os ponteiros para os
+// filhos usam release/acquire, para que um nó novo já esteja montado quando alguém o alcança.
+
+#define GRAU 16                       // Grau mínimo da B-tree
+#define MAX_CHAVES (2 * GRAU - 1)
+#define BIT_TRAVADO 2u
+
+// Acesso relaxado aos campos atômicos do nó
+#define LER(campo) atomic_load_explicit(&(campo), memory_order_relaxed)
+#define ESCREVER(campo, valor) atomic_store_explicit(&(campo), (valor), memory_order_relaxed)
+
+// Estrutura de um nó da B-tree concorrente
+typedef struct NoConcorrente {
+    _Atomic uint64_t versao;
+    _Atomic int folha;
+    _Atomic int num_chaves;
+    _Atomic int chaves[MAX_CHAVES];
+    _Atomic(struct NoConcorrente*) filhos[MAX_CHAVES + 1];
+} NoConcorrente;
+
+// Estrutura da árvore: a raiz muda quando ela é dividida
+typedef struct {
+    _Atomic(NoConcorrente*) raiz;
+} BTreeConcorrente;
+
+// Função para criar um novo nó
+NoConcorrente* criarNo(int folha) {
+    NoConcorrente *no = (NoConcorrente*)calloc(1, sizeof(NoConcorrente));
+    if (no == NULL) {
+        printf("Erro: Falha ao alocar memória para o novo nó.\n");
+        exit(-1);
+    }
+    atomic_init(&no->versao, 0);
+    atomic_init(&no->folha, folha);
+    return no;
+}
+
+// Função para criar uma árvore vazia
+BTreeConcorrente* criarArvore() {
+    BTreeConcorrente *arv = (BTreeConcorrente*)malloc(sizeof(BTreeConcorrente));
+    atomic_init(&arv->raiz, criarNo(1));
+    return arv;
+}
+
+// Espera o nó ser destravado e retorna a versão lida (início de uma leitura otimista)
+uint64_t lerVersao(NoConcorrente *no) {
+    uint64_t v = atomic_load_explicit(&no->versao, memory_order_acquire);
+    while (v & BIT_TRAVADO) {
+        _mm_pause();
+        v = atomic_load_explicit(&no->versao, memory_order_acquire);
+    }
+    return v;
+}
+
+// Confere se o nó não mudou desde que a versão v foi lida; retorna 0 se for preciso recomeçar
+int validarVersao(NoConcorrente *no, uint64_t v) {
+    atomic_thread_fence(memory_order_acquire);
+    return atomic_load_explicit(&no->versao, memory_order_relaxed) == v;
+}
+
+// Tenta transformar a leitura da versão v em trava de escrita; retorna 0 se o nó mudou
+int travarVersao(NoConcorrente *no, uint64_t v) {
+    return atomic_compare_exchange_strong_explicit(&no->versao, &v, v + BIT_TRAVADO,
+                                                   memory_order_acquire, memory_order_relaxed);
+}
+
+// Destrava o nó, gerando uma nova versão
+void destravar(NoConcorrente *no) {
+    atomic_fetch_add_explicit(&no->versao, BIT_TRAVADO, memory_order_release);
+}
+
+// Ponteiro para o filho i; o acquire pareia com o release de quem ligou o filho ao nó
+NoConcorrente* lerFilho(NoConcorrente *no, int i) {
+    return atomic_load_explicit(&no->filhos[i], memory_order_acquire);
+}
+
+void ligarFilho(NoConcorrente *no, int i, NoConcorrente *filho) {
+    atomic_store_explicit(&no->filhos[i], filho, memory_order_release);
+}
+
+// Quantidade de chaves lida de forma segura mesmo durante uma escrita concorrente
+int numChaves(NoConcorrente *no) {
+    int n = LER(no->num_chaves);
+    return n < 0 ? 0 : (n > MAX_CHAVES ? MAX_CHAVES : n);
+}
+
+// Posição da primeira chave >= chave
+int limiteInferior(NoConcorrente *no, int n, int chave) {
+    int i = 0;
+    while (i < n && LER(no->chaves[i]) < chave) {
+        i++;
+    }
+    return i;
+}
+
+// Função para buscar uma chave; retorna 1 se encontrada
+// Nenhuma escrita em memória compartilhada: só leituras e validações de versão
+int buscar(BTreeConcorrente *arv, int chave) {
+recomecar:;
+    NoConcorrente *no = atomic_load_explicit(&arv->raiz, memory_order_acquire);
+    uint64_t v = lerVersao(no);
+    if (no != atomic_load_explicit(&arv->raiz, memory_order_acquire)) {
+        goto recomecar;  // A raiz foi trocada por uma divisão
+    }
+
+    while (1) {
+        int n = numChaves(no);
+        int i = limiteInferior(no, n, chave);
+        int encontrada = i < n && LER(no->chaves[i]) == chave;
+        int folha = LER(no->folha);
+        NoConcorrente *filho = folha ? NULL : lerFilho(no, i);
+        if (!validarVersao(no, v)) {
+            goto recomecar;
+        }
+        if (encontrada) {
+            return 1;
+        }
+        if (folha) {
+            return 0;
+        }
+
+        uint64_t vFilho = lerVersao(filho);
+        if (!validarVersao(no, v)) {
+            goto recomecar;  // O pai mudou entre a leitura do ponteiro e a do filho
+        }
+        no = filho;
+        v = vFilho;
+    }
+}
+
+// Divide o nó cheio filho (travado), colocando a chave do meio no pai (travado ou NULL se filho é a raiz)
+void dividirNo(BTreeConcorrente *arv, NoConcorrente *pai, NoConcorrente *filho) {
+    int folha = LER(filho->folha);
+    NoConcorrente *novo_no = criarNo(folha);
+    ESCREVER(novo_no->num_chaves, GRAU - 1);
+    for (int j = 0; j < GRAU - 1; j++) {
+        ESCREVER(novo_no->chaves[j], LER(filho->chaves[j + GRAU]));
+    }
+    if (!folha) {
+        for (int j = 0; j < GRAU; j++) {
+            ESCREVER(novo_no->filhos[j], LER(filho->filhos[j + GRAU]));
+        }
+    }
+    int meio = LER(filho->chaves[GRAU - 1]);
+    ESCREVER(filho->num_chaves, GRAU - 1);
+
+    if (pai == NULL) {
+        // O filho era a raiz: a nova raiz fica com a chave do meio e os dois nós
+        NoConcorrente *novaRaiz = criarNo(0);
+        ESCREVER(novaRaiz->num_chaves, 1);
+        ESCREVER(novaRaiz->chaves[0], meio);
+        ESCREVER(novaRaiz->filhos[0], filho);
+        ESCREVER(novaRaiz->filhos[1], novo_no);
+        atomic_store_explicit(&arv->raiz, novaRaiz, memory_order_release);
+        return;
+    }
+
+    int i = LER(pai->num_chaves);
+    while (i > 0 && LER(pai->chaves[i - 1]) > meio) {
+        ESCREVER(pai->chaves[i], LER(pai->chaves[i - 1]));
+        ESCREVER(pai->filhos[i + 1], LER(pai->filhos[i]));
+        i--;
+    }
+    ESCREVER(pai->chaves[i], meio);
+    ligarFilho(pai, i + 1, novo_no);  // Publica o nó novo já montado
+    ESCREVER(pai->num_chaves, LER(pai->num_chaves) + 1);
+}
+
+// Função para inserir uma chave
+// A descida é otimista; um nó cheio encontrado no caminho é dividido travando só ele e o pai,
+// e a inserção recomeça da raiz. Na folha, apenas ela é travada
+void inserir(BTreeConcorrente *arv, int chave) {
+recomecar:;
+    NoConcorrente *no = atomic_load_explicit(&arv->raiz, memory_order_acquire);
+    uint64_t v = lerVersao(no);
+    if (no != atomic_load_explicit(&arv->raiz, memory_order_acquire)) {
+        goto recomecar;
+    }
+    NoConcorrente *pai = NULL;
+    uint64_t vPai = 0;
+
+    while (1) {
+        if (LER(no->num_chaves) == MAX_CHAVES) {
+            // Divisão preventiva: trava o pai e depois o nó
+            if (pai != NULL && !travarVersao(pai, vPai)) {
+                goto recomecar;
+            }
+            if (!travarVersao(no, v)) {
+                if (pai != NULL) {
+                    destravar(pai);
+                }
+                goto recomecar;
+            }
+            if (pai == NULL && no != atomic_load_explicit(&arv->raiz, memory_order_acquire)) {
+                destravar(no);  // Outra thread já trocou a raiz
+                goto recomecar;
+            }
+            dividirNo(arv, pai, no);
+            destravar(no);
+            if (pai != NULL) {
+                destravar(pai);
+            }
+            goto recomecar;
+        }
+
+        if (LER(no->folha)) {
+            if (!travarVersao(no, v)) {
+                goto recomecar;
+            }
+            if (pai != NULL && !validarVersao(pai, vPai)) {
+                destravar(no);
+                goto recomecar;
+            }
+            int i = LER(no->num_chaves);
+            while (i > 0 && LER(no->chaves[i - 1]) > chave) {
+                ESCREVER(no->chaves[i], LER(no->chaves[i - 1]));
+                i--;
+            }
+            ESCREVER(no->chaves[i], chave);
+            ESCREVER(no->num_chaves, LER(no->num_chaves) + 1);
+            destravar(no);
+            return;
+        }
+
+        // Desce pelo primeiro filho cuja chave separadora é maior que a chave
+        int n = numChaves(no);
+        int i = n;
+        while (i > 0 && LER(no->chaves[i - 1]) > chave) {
+            i--;
+        }
+        NoConcorrente *filho = lerFilho(no, i);
+        if (!validarVersao(no, v)) {
+            goto recomecar;
+        }
+        uint64_t vFilho = lerVersao(filho);
+        if (!validarVersao(no, v)) {
+            goto recomecar;
+        }
+        pai = no;
+        vPai = v;
+        no = filho;
+        v = vFilho;
+    }
+}
+
+// Função para imprimir a árvore em ordem (sem concorrência)
+void imprimirEmOrdem(NoConcorrente *no) {
+    for (int i = 0; i < no->num_chaves; i++) {
+        if (!no->folha) {
+            imprimirEmOrdem(no->filhos[i]);
+        }
+        printf("%d ", no->chaves[i]);
+    }
+    if (!no->folha) {
+        imprimirEmOrdem(no->filhos[no->num_chaves]);
+    }
+}
+
+// Conta as chaves da subárvore (sem concorrência)
+long long contarChaves(NoConcorrente *no) {
+    long long total = no->num_chaves;
+    if (!no->folha) {
+        for (int i = 0; i <= no->num_chaves; i++) {
+            total += contarChaves(no->filhos[i]);
+        }
+    }
+    return total;
+}
+
+// Função para liberar a memória (sem concorrência)
+void liberarNos(NoConcorrente *no) {
+    if (!no->folha) {
+        for (int i = 0; i <= no->num_chaves; i++) {
+            liberarNos(no->filhos[i]);
+        }
+    }
+    free(no);
+}
+
+// Retorna o tempo atual em segundos, usado no benchmark
+double tempoAtual() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Parâmetros e resultado de uma thread do benchmark
+typedef struct {
+    BTreeConcorrente *arv;
+    int operacoes;
+    int percentualLeitura;
+    int intervalo;
+    uint64_t semente;
+    long long encontradas;
+    long long insercoes;
+} TrabalhoBenchmark;
+
+// Gerador xorshift64 (cada thread tem o seu estado)
+uint64_t proximoAleatorio(uint64_t *estado) {
+    uint64_t x = *estado;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return *estado = x;
+}
+
+// Laço de operações de uma thread do benchmark
+void *executarTrabalho(void *arg) {
+    TrabalhoBenchmark *t = (TrabalhoBenchmark*)arg;
+    // Estado e contadores em variáveis locais: os trabalhos das threads são vizinhos no vetor, e
+    // escrever neles a cada operação faria as threads disputarem as mesmas linhas de cache
+    uint64_t semente = t->semente;
+    long long encontradas = 0, insercoes = 0;
+    for (int i = 0; i < t->operacoes; i++) {
+        uint64_t r = proximoAleatorio(&semente);
+        int chave = (int)((r >> 8) % (uint64_t)t->intervalo);
+        if ((int)(r & 127) * 100 < t->percentualLeitura * 128) {
+            encontradas += buscar(t->arv, chave);
+        } else {
+            inserir(t->arv, chave);
+            insercoes++;
+        }
+    }
+    t->semente = semente;
+    t->encontradas = encontradas;
+    t->insercoes = insercoes;
+    return NULL;
+}
+
+// Benchmark: vazão com 1 até maxThreads threads, para 90/10 e 50/50 de leituras/escritas
+void benchmark(int n, int operacoes, int maxThreads) {
+    int percentuais[] = {90, 50};
+    printf("%d chaves iniciais, %d operacoes por thread\n", n, operacoes);
+    for (int p = 0; p < 2; p++) {
+        for (int threads = 1; threads <= maxThreads; threads = (threads * 2 > maxThreads && threads != maxThreads) ? maxThreads : threads * 2) {
+            BTreeConcorrente *arv = criarArvore();
+            for (int i = 0; i < n; i++) {
+                inserir(arv, (int)((i * 2654435761u) % (uint32_t)(2 * n)));
+            }
+
+            pthread_t ids[threads];
+            TrabalhoBenchmark trabalhos[threads];
+            for (int t = 0; t < threads; t++) {
+                trabalhos[t] = (TrabalhoBenchmark){arv, operacoes, percentuais[p], 2 * n, 0x9E3779B97F4A7C15ull * (t + 1), 0, 0};
+            }
+            double inicio = tempoAtual();
+            for (int t = 0; t < threads; t++) {
+                pthread_create(&ids[t], NULL, executarTrabalho, &trabalhos[t]);
+            }
+            long long insercoes = 0;
+            for (int t = 0; t < threads; t++) {
+                pthread_join(ids[t], NULL);
+                insercoes += trabalhos[t].insercoes;
+            }
+            double tempo = tempoAtual() - inicio;
+
+            NoConcorrente *raiz = atomic_load(&arv->raiz);
+            long long esperado = n + insercoes;
+            printf("%d%% leituras, %2d threads: %7.2f M ops/s (%s)\n", percentuais[p], threads,
+                   (double)operacoes * threads / tempo / 1e6,
+                   contarChaves(raiz) == esperado ? "contagem ok" : "CONTAGEM ERRADA");
+            liberarNos(raiz);
+            free(arv);
+            if (threads == maxThreads) {
+                break;
+            }
+        }
+    }
+}
+
+// Função principal
+// Uso: AntonioRafael_BTreeConcorrente [bench [n] [operacoes] [threads]]
+int main(int argc, char *argv[]) {
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+        int n = argc > 2 ? atoi(argv[2]) : 1000000;
+        int operacoes = argc > 3 ? atoi(argv[3]) : 2000000;
+        int threads = argc > 4 ? atoi(argv[4]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+        benchmark(n, operacoes, threads);
+        return 0;
+    }
+
+    BTreeConcorrente *arv = criarArvore();
+
+    // Inserindo algumas chaves para teste
+    inserir(arv, 10);
+    inserir(arv, 20);
+    inserir(arv, 5);
+    inserir(arv, 6);
+    inserir(arv, 12);
+    inserir(arv, 30);
+    inserir(arv, 25);
+
+    printf("Impressao da B-tree em ordem:\n");
+    imprimirEmOrdem(atomic_load(&arv->raiz));
+    printf("\n");
+
+    // Teste de busca
+    int chave_busca = 12;
+    if (buscar(arv, chave_busca)) {
+        printf("Chave %d encontrada na B-tree.\n", chave_busca);
+    } else {
+        printf("Chave %d não encontrada na B-tree.\n", chave_busca);
+    }
+
+    liberarNos(atomic_load(&arv->raiz));
+    free(arv);
+    return 0;
+}
@@ -0,0 +1,517 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// B-tree em disco: cada nó é uma página de tamanho fixo (4 ou 16 KiB) de um arquivo.
+// As páginas são mapeadas com mmap sob demanda em um pool pequeno de frames, com
+// substituição pelo algoritmo do relógio (clock), então o conjunto residente fica limitado
+// a numFrames páginas, independentemente do tamanho da árvore.
+//
+// Layout do arquivo:
+//   página 0    -> metadados (Metadados)
+//   página 1..  -> nós: cabeçalho | chaves[2*grau-1] | filhos[2*grau] (números de página)
+
+#define TAMANHO_PAGINA_PADRAO 4096
+#define FRAMES_PADRAO 64
+#define MINIMO_PAGINA 4096
+// A inserção fixa até 3 páginas e a varredura em ordem uma por nível; com páginas de pelo menos
+// MINIMO_PAGINA bytes (grau >= 256) e no máximo 2^32 páginas, a árvore tem no máximo 5 níveis
+#define MINIMO_FRAMES 8
+#define PAGINA_NULA 0          // A página 0 guarda os metadados, então nunca é filho de ninguém
+#define FRAME_NULO -1
+#define MAGICO_BTREE 0x44425442u // "BTBD"
+
+// Metadados gravados na página 0
+typedef struct {
+    uint32_t magico;
+    uint32_t tamanhoPagina;
+    uint32_t grau;
+    uint32_t raiz;         // Página da raiz
+    uint32_t numPaginas;   // Páginas em uso (incluindo a de metadados)
+    uint32_t reservado;
+    uint64_t numChaves;
+} Metadados;
+
+// Cabeçalho no início de cada página de nó
+typedef struct {
+    uint32_t num_chaves;
+    uint32_t folha;
+} CabecalhoPagina;
+
+// Frame do pool: uma janela mapeada para uma página do arquivo
+typedef struct {
+    uint32_t pagina;   // Página mapeada neste frame (PAGINA_NULA se vazio)
+    char *dados;       // Endereço do mapeamento
+    int fixado;        // Quantas referências ativas impedem o despejo
+    int referencia;    // Bit de referência do relógio
+    int proximo;       // Próximo frame na mesma lista da tabela hash
+} Frame;
+
+// Estrutura da B-tree em disco
+typedef struct {
+    int fd;
+    uint32_t tamanhoPagina;
+    uint32_t grau;
+    off_t tamanhoArquivo;
+    Metadados *meta;   // Página 0, mapeada durante toda a vida da árvore
+    Frame *frames;
+    int numFrames;
+    int relogio;       // Ponteiro do relógio
+    int *tabela;       // Tabela hash página -> primeiro frame da lista
+    int tamTabela;
+    uint64_t mapeamentos; // Páginas trazidas para o pool
+    uint64_t despejos;    // Páginas retiradas do pool
+} BTreeDisco;
+
+// Visão de um nó fixado no pool (válida até soltarNo)
+typedef struct {
+    uint32_t pagina;
+    int frame;
+    CabecalhoPagina *cab;
+    int32_t *chaves;
+    uint32_t *filhos;
+} NoDisco;
+
+// Calcula o grau mínimo que cabe em uma página: 8 + 4*(2t-1) + 4*2t <= tamanhoPagina
+uint32_t grauParaPagina(uint32_t tamanhoPagina) {
+    return (tamanhoPagina - sizeof(CabecalhoPagina) + 4) / 16;
+}
+
+// Função auxiliar para encerrar o programa em caso de erro de E/S
+void falhar(const char *mensagem) {
+    perror(mensagem);
+    exit(-1);
+}
+
+// Garante que o arquivo tenha espaço para numPaginas páginas (cresce dobrando)
+void garantirTamanho(BTreeDisco *arv, uint32_t numPaginas) {
+    off_t necessario = (off_t)numPaginas * arv->tamanhoPagina;
+    if (necessario <= arv->tamanhoArquivo) {
+        return;
+    }
+    off_t novo = arv->tamanhoArquivo * 2;
+    if (novo < necessario) {
+        novo = necessario;
+    }
+    if (ftruncate(arv->fd, novo) != 0) {
+        falhar("ftruncate");
+    }
+    arv->tamanhoArquivo = novo;
+}
+
+// Retira o frame da lista da tabela hash
+void removerDaTabela(BTreeDisco *arv, int f) {
+    int *ligacao = &arv->tabela[arv->frames[f].pagina % arv->tamTabela];
+    while (*ligacao != f) {
+        ligacao = &arv->frames[*ligacao].proximo;
+    }
+    *ligacao = arv->frames[f].proximo;
+}
+
+// Escolhe um frame para despejo pelo algoritmo do relógio
+int escolherVitima(BTreeDisco *arv) {
+    for (int voltas = 0; voltas < 2 * arv->numFrames + 1; voltas++) {
+        int f = arv->relogio;
+        arv->relogio = (arv->relogio + 1) % arv->numFrames;
+        Frame *frame = &arv->frames[f];
+        if (frame->fixado > 0) {
+            continue;
+        }
+        if (frame->referencia) {
+            frame->referencia = 0;  // Segunda chance
+            continue;
+        }
+        return f;
+    }
+    printf("Erro: Todos os frames do pool estao fixados.\n");
+    exit(-1);
+}
+
+// Fixa uma página no pool, mapeando-a se necessário, e retorna o frame
+int fixarPagina(BTreeDisco *arv, uint32_t pagina) {
+    for (int f = arv->tabela[pagina % arv->tamTabela]; f != FRAME_NULO; f = arv->frames[f].proximo) {
+        if (arv->frames[f].pagina == pagina) {
+            arv->frames[f].fixado++;
+            arv->frames[f].referencia = 1;
+            return f;
+        }
+    }
+
+    int f = escolherVitima(arv);
+    Frame *frame = &arv->frames[f];
+    if (frame->pagina != PAGINA_NULA) {
+        removerDaTabela(arv, f);
+        arv->despejos++;
+    }
+    // Reaproveita o endereço do frame com MAP_FIXED, substituindo o mapeamento antigo
+    void *endereco = mmap(frame->dados, arv->tamanhoPagina, PROT_READ | PROT_WRITE,
+                          MAP_SHARED | (frame->dados ? MAP_FIXED : 0), arv->fd,
+                          (off_t)pagina * arv->tamanhoPagina);
+    if (endereco == MAP_FAILED) {
+        falhar("mmap");
+    }
+    frame->dados = (char*)endereco;
+    frame->pagina = pagina;
+    frame->fixado = 1;
+    frame->referencia = 1;
+    frame->proximo = arv->tabela[pagina % arv->tamTabela];
+    arv->tabela[pagina % arv->tamTabela] = f;
+    arv->mapeamentos++;
+    return f;
+}
+
+// Monta a visão de um nó a partir de um frame fixado
+NoDisco visaoNo(BTreeDisco *arv, uint32_t pagina, int f) {
+    NoDisco no;
+    no.pagina = pagina;
+    no.frame = f;
+    no.cab = (CabecalhoPagina*)arv->frames[f].dados;
+    no.chaves = (int32_t*)(no.cab + 1);
+    no.filhos = (uint32_t*)(no.chaves + 2 * arv->grau - 1);
+    return no;
+}
+
+// Lê (fixa) o nó guardado em uma página
+NoDisco lerNo(BTreeDisco *arv, uint32_t pagina) {
+    return visaoNo(arv, pagina, fixarPagina(arv, pagina));
+}
+
+// Solta um nó, permitindo que a página seja despejada
+void soltarNo(BTreeDisco *arv, NoDisco *no) {
+    arv->frames[no->frame].fixado--;
+}
+
+// Função para criar um novo nó em uma página nova do arquivo
+NoDisco criarNo(BTreeDisco *arv, int folha) {
+    uint32_t pagina = arv->meta->numPaginas++;
+    garantirTamanho(arv, arv->meta->numPaginas);
+    NoDisco no = lerNo(arv, pagina);
+    no.cab->num_chaves = 0;
+    no.cab->folha = folha;
+    return no;
+}
+
+// Encerra o programa se o tamanho de página (pedido ou lido do arquivo) não puder ser usado:
+// abaixo de MINIMO_PAGINA o grau fica pequeno demais (com 0, grauParaPagina daria a volta),
+// e o mmap exige múltiplos da página do sistema
+void validarTamanhoPagina(uint32_t tamanhoPagina) {
+    long paginaSistema = sysconf(_SC_PAGESIZE);
+    if (tamanhoPagina < MINIMO_PAGINA) {
+        printf("Erro: O tamanho da pagina deve ser de pelo menos %d bytes (recebido %u).\n", MINIMO_PAGINA, tamanhoPagina);
+        exit(-1);
+    }
+    if (tamanhoPagina % (uint32_t)paginaSistema != 0) {
+        printf("Erro: O tamanho da pagina deve ser multiplo de %ld bytes (recebido %u).\n", paginaSistema, tamanhoPagina);
+        exit(-1);
+    }
+}
+
+// Função para abrir (ou criar) uma B-tree em disco
+// tamanhoPagina só é usado na criação; um arquivo existente mantém o tamanho gravado nele
+BTreeDisco* abrirBTreeDisco(const char *caminho, uint32_t tamanhoPagina, int numFrames) {
+    if (numFrames < MINIMO_FRAMES) {
+        printf("Erro: O pool precisa de pelo menos %d frames (recebido %d).\n", MINIMO_FRAMES, numFrames);
+        exit(-1);
+    }
+    BTreeDisco *arv = (BTreeDisco*)calloc(1, sizeof(BTreeDisco));
+    arv->fd = open(caminho, O_RDWR | O_CREAT, 0644);
+    if (arv->fd < 0) {
+        falhar("open");
+    }
+    struct stat info;
+    fstat(arv->fd, &info);
+    arv->tamanhoArquivo = info.st_size;
+
+    int novo = info.st_size < (off_t)sizeof(Metadados);
+    if (!novo) {
+        Metadados lido;
+        if (pread(arv->fd, &lido, sizeof(lido), 0) != sizeof(lido) || lido.magico != MAGICO_BTREE) {
+            printf("Erro: %s nao e um arquivo de B-tree valido.\n", caminho);
+            exit(-1);
+        }
+        tamanhoPagina = lido.tamanhoPagina;
+    }
+    validarTamanhoPagina(tamanhoPagina);
+    arv->tamanhoPagina = tamanhoPagina;
+    arv->grau = grauParaPagina(tamanhoPagina);
+    if (novo) {
+        garantirTamanho(arv, 2);
+    }
+
+    arv->meta = (Metadados*)mmap(NULL, tamanhoPagina, PROT_READ | PROT_WRITE, MAP_SHARED, arv->fd, 0);
+    if (arv->meta == MAP_FAILED) {
+        falhar("mmap");
+    }
+
+    arv->numFrames = numFrames;
+    arv->frames = (Frame*)calloc(numFrames, sizeof(Frame));
+    arv->tamTabela = 2 * numFrames;
+    arv->tabela = (int*)malloc(arv->tamTabela * sizeof(int));
+    for (int i = 0; i < arv->tamTabela; i++) {
+        arv->tabela[i] = FRAME_NULO;
+    }
+
+    if (novo) {
+        arv->meta->magico = MAGICO_BTREE;
+        arv->meta->tamanhoPagina = tamanhoPagina;
+        arv->meta->grau = arv->grau;
+        arv->meta->numPaginas = 1;
+        arv->meta->numChaves = 0;
+        NoDisco raiz = criarNo(arv, 1);
+        arv->meta->raiz = raiz.pagina;
+        soltarNo(arv, &raiz);
+    }
+    return arv;
+}
+
+// Função para fechar a B-tree, desfazendo todos os mapeamentos
+void fecharBTreeDisco(BTreeDisco *arv) {
+    for (int f = 0; f < arv->numFrames; f++) {
+        if (arv->frames[f].dados != NULL) {
+            munmap(arv->frames[f].dados, arv->tamanhoPagina);
+        }
+    }
+    // Reduz o arquivo às páginas realmente usadas
+    off_t usado = (off_t)arv->meta->numPaginas * arv->tamanhoPagina;
+    munmap(arv->meta, arv->tamanhoPagina);
+    if (ftruncate(arv->fd, usado) != 0) {
+        falhar("ftruncate");
+    }
+    close(arv->fd);
+    free(arv->frames);
+    free(arv->tabela);
+    free(arv);
+}
+
+// Função auxiliar para dividir o filho cheio pai->filhos[i]
+void dividirFilho(BTreeDisco *arv, NoDisco *pai, int i) {
+    int grau = arv->grau;
+    NoDisco filho = lerNo(arv, pai->filhos[i]);
+    NoDisco novo_no = criarNo(arv, filho.cab->folha);
+    novo_no.cab->num_chaves = grau - 1;
+
+    // Move as últimas chaves (e filhos) do filho para o novo nó
+    memcpy(novo_no.chaves, filho.chaves + grau, (grau - 1) * sizeof(int32_t));
+    if (!filho.cab->folha) {
+        memcpy(novo_no.filhos, filho.filhos + grau, grau * sizeof(uint32_t));
+    }
+    filho.cab->num_chaves = grau - 1;
+
+    // Abre espaço no pai para o novo filho e para a chave do meio
+    int n = pai->cab->num_chaves;
+    memmove(pai->filhos + i + 2, pai->filhos + i + 1, (n - i) * sizeof(uint32_t));
+    pai->filhos[i + 1] = novo_no.pagina;
+    memmove(pai->chaves + i + 1, pai->chaves + i, (n - i) * sizeof(int32_t));
+    pai->chaves[i] = filho.chaves[grau - 1];
+    pai->cab->num_chaves++;
+
+    soltarNo(arv, &novo_no);
+    soltarNo(arv, &filho);
+}
+
+// Função para inserir uma chave na B-tree em disco
+// A descida é iterativa e mantém no máximo três páginas fixadas ao mesmo tempo
+void inserir(BTreeDisco *arv, int chave) {
+    NoDisco no = lerNo(arv, arv->meta->raiz);
+
+    if (no.cab->num_chaves == 2 * arv->grau - 1) {
+        // Raiz cheia: cria uma nova raiz e divide a antiga
+        NoDisco novaRaiz = criarNo(arv, 0);
+        novaRaiz.filhos[0] = no.pagina;
+        soltarNo(arv, &no);
+        dividirFilho(arv, &novaRaiz, 0);
+        arv->meta->raiz = novaRaiz.pagina;
+        no = novaRaiz;
+    }
+
+    while (!no.cab->folha) {
+        int i = no.cab->num_chaves;
+        while (i > 0 && no.chaves[i - 1] > chave) {
+            i--;
+        }
+        NoDisco filho = lerNo(arv, no.filhos[i]);
+        if (filho.cab->num_chaves == 2 * arv->grau - 1) {
+            soltarNo(arv, &filho);
+            dividirFilho(arv, &no, i);
+            if (no.chaves[i] < chave) {
+                i++;
+            }
+            filho = lerNo(arv, no.filhos[i]);
+        }
+        soltarNo(arv, &no);
+        no = filho;
+    }
+
+    // Insere na folha deslocando as chaves maiores
+    int i = no.cab->num_chaves;
+    while (i > 0 && no.chaves[i - 1] > chave) {
+        no.chaves[i] = no.chaves[i - 1];
+        i--;
+    }
+    no.chaves[i] = chave;
+    no.cab->num_chaves++;
+    soltarNo(arv, &no);
+    arv->meta->numChaves++;
+}
+
+// Função para buscar uma chave na B-tree em disco; retorna 1 se encontrada
+int buscar(BTreeDisco *arv, int chave) {
+    uint32_t pagina = arv->meta->raiz;
+    while (1) {
+        NoDisco no = lerNo(arv, pagina);
+        uint32_t i = 0;
+        while (i < no.cab->num_chaves && chave > no.chaves[i]) {
+            i++;
+        }
+        int encontrada = i < no.cab->num_chaves && no.chaves[i] == chave;
+        int folha = no.cab->folha;
+        pagina = folha ? PAGINA_NULA : no.filhos[i];
+        soltarNo(arv, &no);
+        if (encontrada) {
+            return 1;  // Chave encontrada
+        }
+        if (folha) {
+            return 0;  // Chave não encontrada
+        }
+    }
+}
+
+// Função para percorrer a B-tree em ordem, chamando visitar para cada chave
+// Fica fixada apenas uma página por nível da árvore
+void percorrerEmOrdem(BTreeDisco *arv, uint32_t pagina, void (*visitar)(int, void*), void *contexto) {
+    NoDisco no = lerNo(arv, pagina);
+    for (uint32_t i = 0; i < no.cab->num_chaves; i++) {
+        if (!no.cab->folha) {
+            percorrerEmOrdem(arv, no.filhos[i], visitar, contexto);
+        }
+        visitar(no.chaves[i], contexto);
+    }
+    if (!no.cab->folha) {
+        percorrerEmOrdem(arv, no.filhos[no.cab->num_chaves], visitar, contexto);
+    }
+    soltarNo(arv, &no);
+}
+
+// Visitante que imprime a chave
+void imprimirChave(int chave, void *contexto) {
+    (void)contexto;
+    printf("%d ", chave);
+}
+
+// Função para imprimir a B-tree em ordem
+void imprimirEmOrdem(BTreeDisco *arv) {
+    percorrerEmOrdem(arv, arv->meta->raiz, imprimirChave, NULL);
+}
+
+// Retorna o tempo atual em segundos, usado no benchmark
+double tempoAtual() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Visitante do benchmark: confere a ordem e conta as chaves
+typedef struct {
+    long long quantidade;
+    int anterior;
+    int foraDeOrdem;
+} ContagemVarredura;
+
+void contarChave(int chave, void *contexto) {
+    ContagemVarredura *c = (ContagemVarredura*)contexto;
+    if (c->quantidade > 0 && chave < c->anterior) {
+        c->foraDeOrdem = 1;
+    }
+    c->anterior = chave;
+    c->quantidade++;
+}
+
+// Benchmark: insere n chaves aleatórias, busca todas e faz uma varredura completa
+void benchmark(const char *caminho, int n, uint32_t tamanhoPagina, int numFrames) {
+    unlink(caminho);
+    BTreeDisco *arv = abrirBTreeDisco(caminho, tamanhoPagina, numFrames);
+    printf("Pagina de %u bytes, grau %u, pool de %d frames (%.1f KiB residentes no maximo)\n",
+           arv->tamanhoPagina, arv->grau, numFrames, numFrames * arv->tamanhoPagina / 1024.0);
+
+    srand(42);
+    double inicio = tempoAtual();
+    for (int i = 0; i < n; i++) {
+        inserir(arv, rand());
+    }
+    double tInsercao = tempoAtual() - inicio;
+    uint64_t mapInsercao = arv->mapeamentos;
+
+    srand(42);
+    int encontradas = 0;
+    inicio = tempoAtual();
+    for (int i = 0; i < n; i++) {
+        encontradas += buscar(arv, rand());
+    }
+    double tBusca = tempoAtual() - inicio;
+
+    ContagemVarredura contagem = {0, 0, 0};
+    inicio = tempoAtual();
+    percorrerEmOrdem(arv, arv->meta->raiz, contarChave, &contagem);
+    double tVarredura = tempoAtual() - inicio;
+
+    printf("insercao : %8.3f s (%6.2f M/s), %llu paginas mapeadas\n", tInsercao, n / tInsercao / 1e6,
+           (unsigned long long)mapInsercao);
+    printf("busca    : %8.3f s (%6.2f M/s), %d encontradas\n", tBusca, n / tBusca / 1e6, encontradas);
+    printf("varredura: %8.3f s (%6.2f M chaves/s), %lld chaves, %s\n", tVarredura,
+           contagem.quantidade / tVarredura / 1e6, contagem.quantidade,
+           contagem.foraDeOrdem ? "FORA DE ORDEM" : "em ordem");
+    printf("arquivo  : %u paginas (%.1f MiB), %llu despejos\n", arv->meta->numPaginas,
+           (double)arv->meta->numPaginas * arv->tamanhoPagina / (1024 * 1024), (unsigned long long)arv->despejos);
+    fecharBTreeDisco(arv);
+}
+
+// Função principal
+// Uso: AntonioRafael_BTreeDisco                       -> demonstração
+//      AntonioRafael_BTreeDisco bench arquivo [n] [pagina] [frames]
+int main(int argc, char *argv[]) {
+    if (argc > 2 && strcmp(argv[1], "bench") == 0) {
+        int n = argc > 3 ? atoi(argv[3]) : 10000000;
+        uint32_t pagina = argc > 4 ? (uint32_t)atoi(argv[4]) : TAMANHO_PAGINA_PADRAO;
+        int frames = argc > 5 ? atoi(argv[5]) : FRAMES_PADRAO;
+        benchmark(argv[2], n, pagina, frames);
+        return 0;
+    }
+
+    const char *caminho = "btree_disco.dat";
+    unlink(caminho);
+    BTreeDisco *arv = abrirBTreeDisco(caminho, TAMANHO_PAGINA_PADRAO, FRAMES_PADRAO);
+
+    // Inserindo algumas chaves para teste
+    inserir(arv, 10);
+    inserir(arv, 20);
+    inserir(arv, 5);
+    inserir(arv, 6);
+    inserir(arv, 12);
+    inserir(arv, 30);
+    inserir(arv, 25);
+    fecharBTreeDisco(arv);
+
+    // Reabre o arquivo para mostrar que a árvore foi persistida
+    arv = abrirBTreeDisco(caminho, TAMANHO_PAGINA_PADRAO, FRAMES_PADRAO);
+    printf("Impressao da B-tree (grau %u) em ordem:\n", arv->grau);
+    imprimirEmOrdem(arv);
+    printf("\n");
+
+    // Teste de busca
+    int chave_busca = 12;
+    if (buscar(arv, chave_busca)) {
+        printf("Chave %d encontrada na B-tree.\n", chave_busca);
+    } else {
+        printf("Chave %d não encontrada na B-tree.\n", chave_busca);
+    }
+
+    fecharBTreeDisco(arv);
+    unlink(caminho);
+    return 0;
+}
@@ -1,106 +1,155 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 
 // Definição dos possíveis valores de cor
 #define VERMELHO 0
 #define PRETO 1
 
 // Definição da estrutura de um nó da árvore Red-Black
+// Filhos e pai são índices de 32 bits no vetor de nós e a cor ocupa o bit mais baixo do campo do pai,
+// então o nó tem 16 bytes (antes: int cor e três ponteiros, 32 bytes)
 typedef struct No {
     int valor;
-    int cor;
-    struct No *esquerda, *direita, *pai;
+    uint32_t esquerda, direita;
+    uint32_t paiCor; // (pai << 1) | cor
 } No;
 
-// Função para criar um novo nó
-No *criarNo(int valor) {
-    No *novoNo = (No *)malloc(sizeof(No));
-    novoNo->valor = valor;
-    novoNo->cor = VERMELHO;
-    novoNo->esquerda = novoNo->direita = novoNo->pai = NULL;
-    return novoNo;
+// O índice 0 é o nó sentinela NIL (sempre preto), usado no lugar de NULL como no livro do Cormen.
+// Durante a exclusão o pai do NIL pode ser ajustado temporariamente, o que evita acessar NULL
+#define NIL 0
+
+// Vetor de nós; os nós excluídos são reaproveitados por uma lista livre ligada pelo campo esquerda
+No *nos = NULL;
+uint32_t usados = 0, capacidade = 0, livre = NIL;
+
+// Funções de acesso ao pai e à cor
+uint32_t pai(uint32_t no) {
+    return nos[no].paiCor >> 1;
+}
+
+int cor(uint32_t no) {
+    return nos[no].paiCor & 1;
 }
 
-// Função auxiliar para verificar se um nó é vermelho
-int ehVermelho(No *no) {
-    return no != NULL && no->cor == VERMELHO;
+void setPai(uint32_t no, uint32_t p) {
+    nos[no].paiCor = (p << 1) | (nos[no].paiCor & 1);
 }
 
 // Função auxiliar para definir a cor de um nó
-void setCor(No *no, int cor) {
-    if (no != NULL) {
-        no->cor = cor;
+void setCor(uint32_t no, int c) {
+    nos[no].paiCor = (nos[no].paiCor & ~1u) | (uint32_t)c;
+}
+
+// Função para criar um novo nó e devolver o seu índice
+uint32_t criarNo(int valor) {
+    uint32_t novoNo;
+    if (livre != NIL) {
+        novoNo = livre;
+        livre = nos[novoNo].esquerda;
+    } else {
+        if (usados == capacidade) {
+            // O pai ocupa 31 bits de paiCor, então os índices não podem passar de 2^31 - 1
+            if (capacidade >= (1u << 31)) {
+                printf("Erro: A árvore excedeu o limite de índices de 31 bits.\n");
+                exit(-1);
+            }
+            capacidade = capacidade ? capacidade * 2 : 64;
+            No *novos = (No *)realloc(nos, capacidade * sizeof(No));
+            if (novos == NULL) {
+                printf("Erro: Falha ao alocar memória para os nós.\n");
+                exit(-1);
+            }
+            nos = novos;
+            if (usados == 0) {
+                nos[NIL].valor = 0;
+                nos[NIL].esquerda = nos[NIL].direita = NIL;
+                nos[NIL].paiCor = (NIL << 1) | PRETO;
+                usados = 1;
+            }
+        }
+        novoNo = usados++;
     }
+    nos[novoNo].valor = valor;
+    nos[novoNo].esquerda = nos[novoNo].direita = NIL;
+    nos[novoNo].paiCor = (NIL << 1) | VERMELHO;
+    return novoNo;
+}
+
+// Função auxiliar para verificar se um nó é vermelho (o NIL é preto)
+int ehVermelho(uint32_t no) {
+    return cor(no) == VERMELHO;
 }
 
 // Função para fazer a rotação à esquerda
-void rotacaoEsquerda(No **raiz, No *x) {
-    No *y = x->direita;
-    x->direita = y->esquerda;
-    if (y->esquerda != NULL)
-        y->esquerda->pai = x;
-    y->pai = x->pai;
-    if (x->pai == NULL)
+void rotacaoEsquerda(uint32_t *raiz, uint32_t x) {
+    uint32_t y = nos[x].direita;
+    nos[x].direita = nos[y].esquerda;
+    if (nos[y].esquerda != NIL)
+        setPai(nos[y].esquerda, x);
+    setPai(y, pai(x));
+    if (pai(x) == NIL)
         *raiz = y;
-    else if (x == x->pai->esquerda)
-        x->pai->esquerda = y;
+    else if (x == nos[pai(x)].esquerda)
+        nos[pai(x)].esquerda = y;
     else
-        x->pai->direita = y;
-    y->esquerda = x;
-    x->pai = y;
+        nos[pai(x)].direita = y;
+    nos[y].esquerda = x;
+    setPai(x, y);
 }
 
 // Função para fazer a rotação à direita
-void rotacaoDireita(No **raiz, No *x) {
-    No *y = x->esquerda;
-    x->esquerda = y->direita;
-    if (y->direita != NULL)
-        y->direita->pai = x;
-    y->pai = x->pai;
-    if (x->pai == NULL)
+void rotacaoDireita(uint32_t *raiz, uint32_t x) {
+    uint32_t y = nos[x].esquerda;
+    nos[x].esquerda = nos[y].direita;
+    if (nos[y].direita != NIL)
+        setPai(nos[y].direita, x);
+    setPai(y, pai(x));
+    if (pai(x) == NIL)
         *raiz = y;
-    else if (x == x->pai->direita)
-        x->pai->direita = y;
+    else if (x == nos[pai(x)].direita)
+        nos[pai(x)].direita = y;
     else
-        x->pai->esquerda = y;
-    y->direita = x;
-    x->pai = y;
+        nos[pai(x)].esquerda = y;
+    nos[y].direita = x;
+    setPai(x, y);
 }
 
 // Função para balancear a árvore após a inserção
-void corrigirViolacao(No **raiz, No *z) {
-    while (ehVermelho(z->pai)) {
-        if (z->pai == z->pai->pai->esquerda) {
-            No *y = z->pai->pai->direita;
+void corrigirViolacao(uint32_t *raiz, uint32_t z) {
+    while (ehVermelho(pai(z))) {
+        uint32_t avo = pai(pai(z));
+        if (pai(z) == nos[avo].esquerda) {
+            uint32_t y = nos[avo].direita;
             if (ehVermelho(y)) {
-                setCor(z->pai, PRETO);
+                setCor(pai(z), PRETO);
                 setCor(y, PRETO);
-                setCor(z->pai->pai, VERMELHO);
-                z = z->pai->pai;
+                setCor(avo, VERMELHO);
+                z = avo;
             } else {
-                if (z == z->pai->direita) {
-                    z = z->pai;
+                if (z == nos[pai(z)].direita) {
+                    z = pai(z);
                     rotacaoEsquerda(raiz, z);
                 }
-                setCor(z->pai, PRETO);
-                setCor(z->pai->pai, VERMELHO);
-                rotacaoDireita(raiz, z->pai->pai);
+                setCor(pai(z), PRETO);
+                setCor(pai(pai(z)), VERMELHO);
+                rotacaoDireita(raiz, pai(pai(z)));
             }
         } else {
-            No *y = z->pai->pai->esquerda;
+            uint32_t y = nos[avo].esquerda;
             if (ehVermelho(y)) {
-                setCor(z->pai, PRETO);
+                setCor(pai(z), PRETO);
                 setCor(y, PRETO);
-                setCor(z->pai->pai, VERMELHO);
-                z = z->pai->pai;
+                setCor(avo, VERMELHO);
+                z = avo;
             } else {
-                if (z == z->pai->esquerda) {
-                    z = z->pai;
+                if (z == nos[pai(z)].esquerda) {
+                    z = pai(z);
                     rotacaoDireita(raiz, z);
                 }
-                setCor(z->pai, PRETO);
-                setCor(z->pai->pai, VERMELHO);
-                rotacaoEsquerda(raiz, z->pai->pai);
+                setCor(pai(z), PRETO);
+                setCor(pai(pai(z)), VERMELHO);
+                rotacaoEsquerda(raiz, pai(pai(z)));
             }
         }
     }
@@ -108,102 +157,101 @@ void corrigirViolacao(No **raiz, No *z) {
 }
 
 // Função para inserir um novo nó na árvore Red-Black
-void inserir(No **raiz, int valor) {
-    No *z = criarNo(valor);
-    No *y = NULL;
-    No *x = *raiz;
+void inserir(uint32_t *raiz, int valor) {
+    uint32_t z = criarNo(valor);
+    uint32_t y = NIL;
+    uint32_t x = *raiz;
 
     // Inserção básica de árvore binária de busca
-    while (x != NULL) {
+    while (x != NIL) {
         y = x;
-        if (z->valor < x->valor)
-            x = x->esquerda;
+        if (valor < nos[x].valor)
+            x = nos[x].esquerda;
         else
-            x = x->direita;
+            x = nos[x].direita;
     }
-    z->pai = y;
-    if (y == NULL)
+    setPai(z, y);
+    if (y == NIL)
         *raiz = z;
-    else if (z->valor < y->valor)
-        y->esquerda = z;
+    else if (valor < nos[y].valor)
+        nos[y].esquerda = z;
     else
-        y->direita = z;
+        nos[y].direita = z;
 
     // Corrige as propriedades da árvore Red-Black
     corrigirViolacao(raiz, z);
 }
 
 // Função para substituir um nó por outro
-void substituirNo(No **raiz, No *u, No *v) {
-    if (u->pai == NULL) {
+// v pode ser o NIL: o pai dele é ajustado mesmo assim, para a correção da exclusão subir a partir dele
+void substituirNo(uint32_t *raiz, uint32_t u, uint32_t v) {
+    if (pai(u) == NIL) {
         *raiz = v;
-    } else if (u == u->pai->esquerda) {
-        u->pai->esquerda = v;
+    } else if (u == nos[pai(u)].esquerda) {
+        nos[pai(u)].esquerda = v;
     } else {
-        u->pai->direita = v;
-    }
-    if (v != NULL) {
-        v->pai = u->pai;
+        nos[pai(u)].direita = v;
     }
+    setPai(v, pai(u));
 }
 
 // Função auxiliar para encontrar o nó mínimo (mais à esquerda)
-No *minimo(No *no) {
-    while (no->esquerda != NULL) {
-        no = no->esquerda;
+uint32_t minimo(uint32_t no) {
+    while (nos[no].esquerda != NIL) {
+        no = nos[no].esquerda;
     }
     return no;
 }
 
 // Função para corrigir a árvore após exclusão
-void corrigirExclusao(No **raiz, No *x) {
-    while (x != *raiz && (x == NULL || x->cor == PRETO)) {
-        if (x == x->pai->esquerda) {
-            No *w = x->pai->direita;
+void corrigirExclusao(uint32_t *raiz, uint32_t x) {
+    while (x != *raiz && cor(x) == PRETO) {
+        if (x == nos[pai(x)].esquerda) {
+            uint32_t w = nos[pai(x)].direita;
             if (ehVermelho(w)) {
                 setCor(w, PRETO);
-                setCor(x->pai, VERMELHO);
-                rotacaoEsquerda(raiz, x->pai);
-                w = x->pai->direita;
+                setCor(pai(x), VERMELHO);
+                rotacaoEsquerda(raiz, pai(x));
+                w = nos[pai(x)].direita;
             }
-            if ((!ehVermelho(w->esquerda)) && (!ehVermelho(w->direita))) {
+            if ((!ehVermelho(nos[w].esquerda)) && (!ehVermelho(nos[w].direita))) {
                 setCor(w, VERMELHO);
-                x = x->pai;
+                x = pai(x);
             } else {
-                if (!ehVermelho(w->direita)) {
-                    setCor(w->esquerda, PRETO);
+                if (!ehVermelho(nos[w].direita)) {
+                    setCor(nos[w].esquerda, PRETO);
                     setCor(w, VERMELHO);
                     rotacaoDireita(raiz, w);
-                    w = x->pai->direita;
+                    w = nos[pai(x)].direita;
                 }
-                setCor(w, x->pai->cor);
-                setCor(x->pai, PRETO);
-                setCor(w->direita, PRETO);
-                rotacaoEsquerda(raiz, x->pai);
+                setCor(w, cor(pai(x)));
+                setCor(pai(x), PRETO);
+                setCor(nos[w].direita, PRETO);
+                rotacaoEsquerda(raiz, pai(x));
                 x = *raiz;
             }
         } else {
-            No *w = x->pai->esquerda;
+            uint32_t w = nos[pai(x)].esquerda;
             if (ehVermelho(w)) {
                 setCor(w, PRETO);
-                setCor(x->pai, VERMELHO);
-                rotacaoDireita(raiz, x->pai);
-                w = x->pai->esquerda;
+                setCor(pai(x), VERMELHO);
+                rotacaoDireita(raiz, pai(x));
+                w = nos[pai(x)].esquerda;
             }
-            if ((!ehVermelho(w->direita)) && (!ehVermelho(w->esquerda))) {
+            if ((!ehVermelho(nos[w].direita)) && (!ehVermelho(nos[w].esquerda))) {
                 setCor(w, VERMELHO);
-                x = x->pai;
+                x = pai(x);
             } else {
-                if (!ehVermelho(w->esquerda)) {
-                    setCor(w->direita, PRETO);
+                if (!ehVermelho(nos[w].esquerda)) {
+                    setCor(nos[w].direita, PRETO);
                     setCor(w, VERMELHO);
                     rotacaoEsquerda(raiz, w);
-                    w = x->pai->esquerda;
+                    w = nos[pai(x)].esquerda;
                 }
-                setCor(w, x->pai->cor);
-                setCor(x->pai, PRETO);
-                setCor(w->esquerda, PRETO);
-                rotacaoDireita(raiz, x->pai);
+                setCor(w, cor(pai(x)));
+                setCor(pai(x), PRETO);
+                setCor(nos[w].esquerda, PRETO);
+                rotacaoDireita(raiz, pai(x));
                 x = *raiz;
             }
         }
@@ -212,77 +260,81 @@ void corrigirExclusao(No **raiz, No *x) {
 }
 
 // Função para excluir um nó da árvore Red-Black
-void excluir(No **raiz, int valor) {
-    No *z = *raiz;
-    while (z != NULL && z->valor != valor) {
-        if (valor < z->valor) {
-            z = z->esquerda;
+void excluir(uint32_t *raiz, int valor) {
+    uint32_t z = *raiz;
+    while (z != NIL && nos[z].valor != valor) {
+        if (valor < nos[z].valor) {
+            z = nos[z].esquerda;
         } else {
-            z = z->direita;
+            z = nos[z].direita;
         }
     }
-    if (z == NULL) return;
+    if (z == NIL) return;
 
-    No *y = z;
-    int yCorOriginal = y->cor;
-    No *x;
+    uint32_t y = z;
+    int yCorOriginal = cor(y);
+    uint32_t x;
 
-    if (z->esquerda == NULL) {
-        x = z->direita;
-        substituirNo(raiz, z, z->direita);
-    } else if (z->direita == NULL) {
-        x = z->esquerda;
-        substituirNo(raiz, z, z->esquerda);
+    if (nos[z].esquerda == NIL) {
+        x = nos[z].direita;
+        substituirNo(raiz, z, nos[z].direita);
+    } else if (nos[z].direita == NIL) {
+        x = nos[z].esquerda;
+        substituirNo(raiz, z, nos[z].esquerda);
     } else {
-        y = minimo(z->direita);
-        yCorOriginal = y->cor;
-        x = y->direita;
-        if (y->pai == z) {
-            if (x != NULL) x->pai = y;
+        y = minimo(nos[z].direita);
+        yCorOriginal = cor(y);
+        x = nos[y].direita;
+        if (pai(y) == z) {
+            setPai(x, y);
         } else {
-            substituirNo(raiz, y, y->direita);
-            y->direita = z->direita;
-            y->direita->pai = y;
+            substituirNo(raiz, y, nos[y].direita);
+            nos[y].direita = nos[z].direita;
+            setPai(nos[y].direita, y);
         }
         substituirNo(raiz, z, y);
-        y->esquerda = z->esquerda;
-        y->esquerda->pai = y;
-        setCor(y, z->cor);
+        nos[y].esquerda = nos[z].esquerda;
+        setPai(nos[y].esquerda, y);
+        setCor(y, cor(z));
     }
 
-    free(z);
+    // Devolve o nó à lista livre
+    nos[z].esquerda = livre;
+    livre = z;
 
     if (yCorOriginal == PRETO) {
         corrigirExclusao(raiz, x);
     }
+    // O NIL volta a ser preto e sem pai
+    nos[NIL].paiCor = (NIL << 1) | PRETO;
 }
 
 // Função para imprimir a árvore de acordo com o formato esquerda-raiz-direita
-void imprimeArvoreRB(No *raiz, int espaco) {
-    if (raiz != NULL) {
+void imprimeArvoreRB(uint32_t raiz, int espaco) {
+    if (raiz != NIL) {
         // Aumenta a distância entre os níveis
         espaco += 10;
 
         // Processa a subárvore direita primeiro
-        imprimeArvoreRB(raiz->direita, espaco);
+        imprimeArvoreRB(nos[raiz].direita, espaco);
 
         // Imprime o nó atual após o espaço apropriado
         printf("\n");
         for (int i = 10; i < espaco; i++)
             printf(" ");
-        if (raiz->cor == VERMELHO)
-            printf("\033[31m%d\033[0m\n", raiz->valor);  // Vermelho
+        if (cor(raiz) == VERMELHO)
+            printf("\033[31m%d\033[0m\n", nos[raiz].valor);  // Vermelho
         else
-            printf("%d\n", raiz->valor);  // Preto
+            printf("%d\n", nos[raiz].valor);  // Preto
 
         // Processa a subárvore esquerda
-        imprimeArvoreRB(raiz->esquerda, espaco);
+        imprimeArvoreRB(nos[raiz].esquerda, espaco);
     }
 }
 
 int main()
 {
-    No *raiz = NULL;
+    uint32_t raiz = NIL;
     // Exemplo de inserção de valores na árvore Red-Black
     int vetor[] = {12, 31, 20, 17, 11, 8, 3, 24, 15, 33};
     int i, tam = sizeof(vetor) / sizeof(vetor[0]);
@@ -295,5 +347,6 @@ int main()
     imprimeArvoreRB(raiz, 3);
     printf("\n");
 
+    free(nos);
     return 0;
 }
@@ -1,6 +1,16 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include "../3 - Arvores/BuscaEmLote.h"
+
+// Metades com menos nós que isso (somando as duas Treaps) rodam na própria thread:
+// são pequenas demais para compensar o custo de criar uma thread
+#define MINIMO_PARALELO 16384
 
 // Definindo um tipo para simplificar o uso do NoTreap
 typedef struct NoTreap {
@@ -12,7 +22,7 @@ typedef struct NoTreap {
 NoTreap* criarNo(int chave) {
     NoTreap* no = (NoTreap*)malloc(sizeof(NoTreap));
     no->chave = chave;
-    no->prioridade = rand() % 100;
+    no->prioridade = rand(); // Prioridades em toda a faixa do rand(), para quase não haver empates
     no->esquerda = no->direita = NULL;
     return no;
 }
@@ -87,6 +97,429 @@ NoTreap* buscar(NoTreap* raiz, int chave) {
     return buscar(raiz->direita, chave);
 }
 
+// Passo de buscarEmLote: termina no nó com a chave (ou em NULL) ou desce para o filho do lado dela
+#define PASSO_TREAP(no, procurada, etapa, terminou) do {              \
+        if (no == NULL || no->chave == procurada)                      \
+            terminou = 1;                                              \
+        else                                                           \
+            no = procurada < no->chave ? no->esquerda : no->direita;   \
+    } while (0)
+
+// Função para buscar n chaves de uma vez; saida[i] recebe o nó de chaves[i] ou NULL
+// As buscas descem intercaladas para sobrepor as faltas de cache (veja BuscaEmLote.h)
+void buscarEmLote(NoTreap* raiz, const int chaves[], int n, NoTreap* saida[]) {
+    BUSCA_EM_LOTE(NoTreap, raiz, chaves, n, saida, PASSO_TREAP);
+}
+
+// Função para liberar memória da Treap
+void destruirTreap(NoTreap* raiz) {
+    if (raiz != NULL) {
+        destruirTreap(raiz->esquerda);
+        destruirTreap(raiz->direita);
+        free(raiz);
+    }
+}
+
+// Função para dividir a Treap pela chave: menores recebe as chaves < chave e maiores as chaves > chave
+// Retorna o nó com a chave (já desligado da árvore) ou NULL se ela não existir
+NoTreap* dividir(NoTreap* raiz, int chave, NoTreap** menores, NoTreap** maiores) {
+    if (raiz == NULL) {
+        *menores = *maiores = NULL;
+        return NULL;
+    }
+    NoTreap* igual;
+    if (raiz->chave < chave) {
+        igual = dividir(raiz->direita, chave, &raiz->direita, maiores);
+        *menores = raiz;
+    } else if (raiz->chave > chave) {
+        igual = dividir(raiz->esquerda, chave, menores, &raiz->esquerda);
+        *maiores = raiz;
+    } else {
+        *menores = raiz->esquerda;
+        *maiores = raiz->direita;
+        raiz->esquerda = raiz->direita = NULL;
+        igual = raiz;
+    }
+    return igual;
+}
+
+// Função para juntar duas Treaps, sendo todas as chaves de menores < todas as chaves de maiores
+NoTreap* juntar(NoTreap* menores, NoTreap* maiores) {
+    if (menores == NULL)
+        return maiores;
+    if (maiores == NULL)
+        return menores;
+    if (menores->prioridade > maiores->prioridade) {
+        menores->direita = juntar(menores->direita, maiores);
+        return menores;
+    }
+    maiores->esquerda = juntar(menores, maiores->esquerda);
+    return maiores;
+}
+
+// Operações de conjunto (união, interseção e diferença) por divisão e conquista.
+// As duas Treaps recebidas são consumidas: os nós são reaproveitados no resultado ou liberados.
+// As duas metades de cada chamada são independentes, então uma delas pode ir para outra thread.
+// Só os primeiros profundidadeParalela níveis (log2 das threads, arredondado para cima) criam
+// threads, então cada operação cria no máximo 2^profundidadeParalela - 1 delas, e nunca mais que
+// threadsLivres ao mesmo tempo; abaixo disso, ou se a metade for pequena, ela roda na própria thread
+typedef NoTreap* (*OperacaoConjunto)(NoTreap*, NoTreap*, int);
+
+typedef struct {
+    OperacaoConjunto operacao;
+    NoTreap *a, *b;
+    int profundidade;
+    NoTreap* resultado;
+} TarefaConjunto;
+
+atomic_int threadsLivres = 0;
+int profundidadeParalela = 0;
+
+void* executarTarefa(void* arg) {
+    TarefaConjunto* t = (TarefaConjunto*)arg;
+    t->resultado = t->operacao(t->a, t->b, t->profundidade);
+    return NULL;
+}
+
+// Tenta reservar uma thread extra; retorna 1 se conseguiu
+int reservarThread() {
+    int livres = atomic_load(&threadsLivres);
+    while (livres > 0) {
+        if (atomic_compare_exchange_weak(&threadsLivres, &livres, livres - 1))
+            return 1;
+    }
+    return 0;
+}
+
+// Conta os nós da subárvore, parando em limite
+int contarAte(NoTreap* raiz, int limite) {
+    if (raiz == NULL || limite <= 0)
+        return 0;
+    int n = 1 + contarAte(raiz->esquerda, limite - 1);
+    return n + contarAte(raiz->direita, limite - n);
+}
+
+// Executa as duas tarefas, a primeira em outra thread se houver uma livre
+void executarMetades(TarefaConjunto* primeira, TarefaConjunto* segunda) {
+    pthread_t id;
+    if (primeira->profundidade <= profundidadeParalela && primeira->a != NULL && primeira->b != NULL &&
+        contarAte(primeira->a, MINIMO_PARALELO) + contarAte(primeira->b, MINIMO_PARALELO) >= MINIMO_PARALELO &&
+        reservarThread()) {
+        if (pthread_create(&id, NULL, executarTarefa, primeira) == 0) {
+            executarTarefa(segunda);
+            pthread_join(id, NULL);
+            atomic_fetch_add(&threadsLivres, 1);
+            return;
+        }
+        atomic_fetch_add(&threadsLivres, 1);
+    }
+    executarTarefa(primeira);
+    executarTarefa(segunda);
+}
+
+// União: a raiz de maior prioridade continua raiz, e a outra Treap é dividida pela chave dela
+NoTreap* uniao(NoTreap* a, NoTreap* b, int profundidade) {
+    if (a == NULL)
+        return b;
+    if (b == NULL)
+        return a;
+    if (a->prioridade < b->prioridade) {
+        NoTreap* temp = a;
+        a = b;
+        b = temp;
+    }
+    NoTreap *menores, *maiores;
+    NoTreap* igual = dividir(b, a->chave, &menores, &maiores);
+    free(igual); // Chave repetida: fica só o nó de a
+
+    TarefaConjunto esquerda = {uniao, a->esquerda, menores, profundidade + 1, NULL};
+    TarefaConjunto direita = {uniao, a->direita, maiores, profundidade + 1, NULL};
+    executarMetades(&esquerda, &direita);
+    a->esquerda = esquerda.resultado;
+    a->direita = direita.resultado;
+    return a;
+}
+
+// Interseção: a raiz de a só continua se a chave também estiver em b
+NoTreap* intersecao(NoTreap* a, NoTreap* b, int profundidade) {
+    if (a == NULL || b == NULL) {
+        destruirTreap(a);
+        destruirTreap(b);
+        return NULL;
+    }
+    if (a->prioridade < b->prioridade) {
+        NoTreap* temp = a;
+        a = b;
+        b = temp;
+    }
+    NoTreap *menores, *maiores;
+    NoTreap* igual = dividir(b, a->chave, &menores, &maiores);
+
+    TarefaConjunto esquerda = {intersecao, a->esquerda, menores, profundidade + 1, NULL};
+    TarefaConjunto direita = {intersecao, a->direita, maiores, profundidade + 1, NULL};
+    executarMetades(&esquerda, &direita);
+    if (igual != NULL) {
+        free(igual);
+        a->esquerda = esquerda.resultado;
+        a->direita = direita.resultado;
+        return a;
+    }
+    free(a);
+    return juntar(esquerda.resultado, direita.resultado);
+}
+
+// Diferença a - b: a é dividida pela raiz de b, e as metades seguem com as subárvores de b
+NoTreap* diferenca(NoTreap* a, NoTreap* b, int profundidade) {
+    if (a == NULL) {
+        destruirTreap(b);
+        return NULL;
+    }
+    if (b == NULL)
+        return a;
+    NoTreap *menores, *maiores;
+    NoTreap* igual = dividir(a, b->chave, &menores, &maiores);
+    free(igual);
+
+    TarefaConjunto esquerda = {diferenca, menores, b->esquerda, profundidade + 1, NULL};
+    TarefaConjunto direita = {diferenca, maiores, b->direita, profundidade + 1, NULL};
+    free(b);
+    executarMetades(&esquerda, &direita);
+    return juntar(esquerda.resultado, direita.resultado);
+}
+
+// Executa uma operação de conjunto usando até threads threads (incluindo a thread atual)
+NoTreap* operacaoParalela(OperacaoConjunto operacao, NoTreap* a, NoTreap* b, int threads) {
+    atomic_store(&threadsLivres, threads - 1);
+    profundidadeParalela = 0;
+    while ((1 << profundidadeParalela) < threads)
+        profundidadeParalela++;
+    NoTreap* resultado = operacao(a, b, 0);
+    atomic_store(&threadsLivres, 0);
+    return resultado;
+}
+
+// Treap implícita (rope): a chave de cada nó é a sua posição na sequência, que não é guardada,
+// mas calculada pelos tamanhos das subárvores. Inserir, remover, dividir e concatenar em qualquer
+// posição custam O(log n) esperado. Inversão e soma em intervalos ficam pendentes no nó (propagação
+// preguiçosa) e só descem para os filhos quando a descida passa por ele
+typedef struct NoImplicito {
+    int valor;
+    int somaPendente;   // Valor a somar em todos os nós das subárvores (o próprio nó já recebeu)
+    uint32_t prioridade;
+    int tamanho;        // Quantidade de nós da subárvore
+    int invertido;      // Os filhos ainda precisam ser trocados (inversão pendente)
+    struct NoImplicito *esquerda, *direita;
+} NoImplicito;
+
+// Gerador xorshift32 para as prioridades: 32 bits inteiros e bem mais rápido que o rand().
+// Com 100M de elementos, prioridades de poucos bits teriam muitos empates e a altura deixaria de ser O(log n)
+uint32_t estadoPrioridade = 2463534242u;
+
+uint32_t proximaPrioridade() {
+    uint32_t x = estadoPrioridade;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return estadoPrioridade = x;
+}
+
+// Função para criar um novo nó da Treap implícita
+NoImplicito* criarNoImplicito(int valor) {
+    NoImplicito* no = (NoImplicito*)malloc(sizeof(NoImplicito));
+    if (no == NULL) {
+        printf("Erro: Falha ao alocar memória para o nó.\n");
+        exit(-1);
+    }
+    no->valor = valor;
+    no->somaPendente = 0;
+    no->prioridade = proximaPrioridade();
+    no->tamanho = 1;
+    no->invertido = 0;
+    no->esquerda = no->direita = NULL;
+    return no;
+}
+
+int tamanho(NoImplicito* no) {
+    return no == NULL ? 0 : no->tamanho;
+}
+
+// Recalcula o tamanho do nó a partir dos filhos
+void atualizarTamanho(NoImplicito* no) {
+    no->tamanho = 1 + tamanho(no->esquerda) + tamanho(no->direita);
+}
+
+// Marcações preguiçosas: aplicam a operação no nó e deixam a dos filhos pendente
+void marcarInversao(NoImplicito* no) {
+    if (no != NULL)
+        no->invertido ^= 1;
+}
+
+void marcarSoma(NoImplicito* no, int delta) {
+    if (no != NULL) {
+        no->valor += delta;
+        no->somaPendente += delta;
+    }
+}
+
+// Empurra as operações pendentes do nó para os filhos (chamada antes de descer por ele)
+void propagar(NoImplicito* no) {
+    if (no->invertido) {
+        NoImplicito* temp = no->esquerda;
+        no->esquerda = no->direita;
+        no->direita = temp;
+        marcarInversao(no->esquerda);
+        marcarInversao(no->direita);
+        no->invertido = 0;
+    }
+    if (no->somaPendente != 0) {
+        marcarSoma(no->esquerda, no->somaPendente);
+        marcarSoma(no->direita, no->somaPendente);
+        no->somaPendente = 0;
+    }
+}
+
+// Função para dividir a sequência: esquerda recebe as k primeiras posições e direita o restante
+void dividirNaPosicao(NoImplicito* raiz, int k, NoImplicito** esquerda, NoImplicito** direita) {
+    if (raiz == NULL) {
+        *esquerda = *direita = NULL;
+        return;
+    }
+    propagar(raiz);
+    if (tamanho(raiz->esquerda) < k) {
+        dividirNaPosicao(raiz->direita, k - tamanho(raiz->esquerda) - 1, &raiz->direita, direita);
+        *esquerda = raiz;
+    } else {
+        dividirNaPosicao(raiz->esquerda, k, esquerda, &raiz->esquerda);
+        *direita = raiz;
+    }
+    atualizarTamanho(raiz);
+}
+
+// Função para concatenar duas sequências (a seguida de b)
+NoImplicito* concatenar(NoImplicito* a, NoImplicito* b) {
+    if (a == NULL)
+        return b;
+    if (b == NULL)
+        return a;
+    if (a->prioridade > b->prioridade) {
+        propagar(a);
+        a->direita = concatenar(a->direita, b);
+        atualizarTamanho(a);
+        return a;
+    }
+    propagar(b);
+    b->esquerda = concatenar(a, b->esquerda);
+    atualizarTamanho(b);
+    return b;
+}
+
+// Função para inserir valor na posição i (0 <= i <= tamanho), deslocando os seguintes
+NoImplicito* inserirNaPosicao(NoImplicito* raiz, int i, int valor) {
+    NoImplicito *esquerda, *direita;
+    dividirNaPosicao(raiz, i, &esquerda, &direita);
+    return concatenar(concatenar(esquerda, criarNoImplicito(valor)), direita);
+}
+
+// Função para remover o elemento da posição i (0 <= i < tamanho)
+NoImplicito* removerDaPosicao(NoImplicito* raiz, int i) {
+    NoImplicito *esquerda, *meio, *direita;
+    dividirNaPosicao(raiz, i, &esquerda, &direita);
+    dividirNaPosicao(direita, 1, &meio, &direita);
+    free(meio);
+    return concatenar(esquerda, direita);
+}
+
+// Função para obter o valor da posição i (0 <= i < tamanho)
+int obterNaPosicao(NoImplicito* raiz, int i) {
+    while (1) {
+        propagar(raiz);
+        int t = tamanho(raiz->esquerda);
+        if (i == t)
+            return raiz->valor;
+        if (i < t) {
+            raiz = raiz->esquerda;
+        } else {
+            i -= t + 1;
+            raiz = raiz->direita;
+        }
+    }
+}
+
+// Funções para inverter ou somar delta nas posições inicio..fim (inclusive)
+NoImplicito* inverterIntervalo(NoImplicito* raiz, int inicio, int fim) {
+    NoImplicito *esquerda, *meio, *direita;
+    dividirNaPosicao(raiz, inicio, &esquerda, &meio);
+    dividirNaPosicao(meio, fim - inicio + 1, &meio, &direita);
+    marcarInversao(meio);
+    return concatenar(concatenar(esquerda, meio), direita);
+}
+
+NoImplicito* somarIntervalo(NoImplicito* raiz, int inicio, int fim, int delta) {
+    NoImplicito *esquerda, *meio, *direita;
+    dividirNaPosicao(raiz, inicio, &esquerda, &meio);
+    dividirNaPosicao(meio, fim - inicio + 1, &meio, &direita);
+    marcarSoma(meio, delta);
+    return concatenar(concatenar(esquerda, meio), direita);
+}
+
+// Função para montar a sequência a partir de um vetor em O(n), como uma árvore cartesiana:
+// uma pilha guarda o caminho mais à direita, com prioridades decrescentes
+NoImplicito* construirSequencia(int vetor[], int n) {
+    if (n <= 0)
+        return NULL;
+    NoImplicito** pilha = (NoImplicito**)malloc((size_t)n * sizeof(NoImplicito*));
+    if (pilha == NULL) {
+        printf("Erro: Falha ao alocar memória para a pilha.\n");
+        exit(-1);
+    }
+    int topo = 0;
+    for (int i = 0; i < n; i++) {
+        NoImplicito* no = criarNoImplicito(vetor[i]);
+        NoImplicito* ultimo = NULL;
+        while (topo > 0 && pilha[topo - 1]->prioridade < no->prioridade) {
+            ultimo = pilha[--topo];
+            atualizarTamanho(ultimo);
+        }
+        no->esquerda = ultimo;
+        if (topo > 0)
+            pilha[topo - 1]->direita = no;
+        pilha[topo++] = no;
+    }
+    while (topo > 1)
+        atualizarTamanho(pilha[--topo]);
+    atualizarTamanho(pilha[0]);
+    NoImplicito* raiz = pilha[0];
+    free(pilha);
+    return raiz;
+}
+
+// Função para imprimir a sequência em ordem
+void imprimirSequencia(NoImplicito* raiz) {
+    if (raiz != NULL) {
+        propagar(raiz);
+        imprimirSequencia(raiz->esquerda);
+        printf("%d ", raiz->valor);
+        imprimirSequencia(raiz->direita);
+    }
+}
+
+// Altura da Treap implícita (sem propagar, a inversão não muda a altura)
+int alturaSequencia(NoImplicito* raiz) {
+    if (raiz == NULL)
+        return 0;
+    int e = alturaSequencia(raiz->esquerda), d = alturaSequencia(raiz->direita);
+    return 1 + (e > d ? e : d);
+}
+
+// Função para liberar memória da Treap implícita
+void destruirSequencia(NoImplicito* raiz) {
+    if (raiz != NULL) {
+        destruirSequencia(raiz->esquerda);
+        destruirSequencia(raiz->direita);
+        free(raiz);
+    }
+}
+
 // Função auxiliar para impressão da Treap com indentação
 void imprimirTreapAuxiliar(NoTreap* raiz, int profundidade) {
     if (raiz == NULL) {
@@ -108,17 +541,230 @@ void imprimirTreap(NoTreap* raiz) {
     imprimirTreapAuxiliar(raiz, 0);
 }
 
-// Função para liberar memória da Treap
-void destruirTreap(NoTreap* raiz) {
-    if (raiz != NULL) {
-        destruirTreap(raiz->esquerda);
-        destruirTreap(raiz->direita);
-        free(raiz);
+// Função para copiar uma Treap (mesmas chaves e prioridades)
+NoTreap* copiarTreap(NoTreap* raiz) {
+    if (raiz == NULL)
+        return NULL;
+    NoTreap* copia = (NoTreap*)malloc(sizeof(NoTreap));
+    copia->chave = raiz->chave;
+    copia->prioridade = raiz->prioridade;
+    copia->esquerda = copiarTreap(raiz->esquerda);
+    copia->direita = copiarTreap(raiz->direita);
+    return copia;
+}
+
+// Conta os nós da Treap
+long long contarNos(NoTreap* raiz) {
+    if (raiz == NULL)
+        return 0;
+    return 1 + contarNos(raiz->esquerda) + contarNos(raiz->direita);
+}
+
+// Insere em destino, uma a uma, todas as chaves de origem
+NoTreap* inserirTodas(NoTreap* destino, NoTreap* origem) {
+    if (origem == NULL)
+        return destino;
+    destino = inserirTodas(destino, origem->esquerda);
+    destino = inserir(destino, origem->chave);
+    return inserirTodas(destino, origem->direita);
+}
+
+// Retorna o tempo atual em segundos, usado no benchmark
+double tempoAtual() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Benchmark: união, interseção e diferença de duas Treaps com n chaves sorteadas em [0, 2n),
+// com 1 até maxThreads threads, comparado com a união chave a chave (inserir cada chave de b em a)
+void benchmark(int n, int maxThreads) {
+    srand(42);
+    NoTreap *a = NULL, *b = NULL;
+    for (int i = 0; i < n; i++) {
+        a = inserir(a, (int)((((unsigned)rand() << 16) ^ (unsigned)rand()) % (unsigned)(2 * n)));
+        b = inserir(b, (int)((((unsigned)rand() << 16) ^ (unsigned)rand()) % (unsigned)(2 * n)));
     }
+    long long tamanhoA = contarNos(a), tamanhoB = contarNos(b);
+    printf("|a| = %lld, |b| = %lld\n", tamanhoA, tamanhoB);
+
+    // Referência: união inserindo as chaves de b uma a uma em uma cópia de a
+    NoTreap* copiaA = copiarTreap(a);
+    NoTreap* copiaB = copiarTreap(b);
+    double inicio = tempoAtual();
+    copiaA = inserirTodas(copiaA, copiaB);
+    double tempoUmAUm = tempoAtual() - inicio;
+    long long esperadoUniao = contarNos(copiaA);
+    long long esperadoIntersecao = tamanhoA + tamanhoB - esperadoUniao;
+    long long esperadoDiferenca = tamanhoA - esperadoIntersecao;
+    printf("Uniao chave a chave:          %8.1f ms\n", tempoUmAUm * 1e3);
+    destruirTreap(copiaA);
+    destruirTreap(copiaB);
+
+    const char* nomes[] = {"Uniao", "Intersecao", "Diferenca"};
+    OperacaoConjunto operacoes[] = {uniao, intersecao, diferenca};
+    long long esperados[] = {esperadoUniao, esperadoIntersecao, esperadoDiferenca};
+    for (int op = 0; op < 3; op++) {
+        double tempoUmaThread = 0;
+        for (int threads = 1; threads <= maxThreads; threads = (threads * 2 > maxThreads && threads != maxThreads) ? maxThreads : threads * 2) {
+            copiaA = copiarTreap(a);
+            copiaB = copiarTreap(b);
+            inicio = tempoAtual();
+            NoTreap* resultado = operacaoParalela(operacoes[op], copiaA, copiaB, threads);
+            double tempo = tempoAtual() - inicio;
+            if (threads == 1)
+                tempoUmaThread = tempo;
+            printf("%-10s %2d threads: %8.1f ms (%.2fx, %s)\n", nomes[op], threads, tempo * 1e3,
+                   tempoUmaThread / tempo, contarNos(resultado) == esperados[op] ? "tamanho ok" : "TAMANHO ERRADO");
+            destruirTreap(resultado);
+            if (threads == maxThreads)
+                break;
+        }
+    }
+    destruirTreap(a);
+    destruirTreap(b);
+}
+
+// Benchmark: n buscas (metade presentes) uma a uma com buscar e em lote com buscarEmLote
+void benchmarkBuscaEmLote(int n) {
+    int* consultas = (int*)malloc((size_t)n * sizeof(int));
+    NoTreap** saida = (NoTreap**)malloc((size_t)n * sizeof(NoTreap*));
+    if (consultas == NULL || saida == NULL) {
+        printf("Erro: Falha ao alocar memória para o benchmark.\n");
+        exit(-1);
+    }
+    srand(3);
+    NoTreap* raiz = NULL;
+    for (int i = 0; i < n; i++) {
+        consultas[i] = rand();
+        raiz = inserir(raiz, consultas[i]);
+    }
+    // Metade das consultas são chaves inseridas (as posições ímpares), a outra metade é aleatória
+    for (int i = 0; i < n; i += 2)
+        consultas[i] = rand();
+
+    long long encontradasUmaAUma = 0, encontradasLote = 0;
+    double inicio = tempoAtual();
+    for (int i = 0; i < n; i++)
+        encontradasUmaAUma += buscar(raiz, consultas[i]) != NULL;
+    double tUmaAUma = tempoAtual() - inicio;
+
+    inicio = tempoAtual();
+    buscarEmLote(raiz, consultas, n, saida);
+    double tLote = tempoAtual() - inicio;
+    for (int i = 0; i < n; i++)
+        encontradasLote += saida[i] != NULL;
+
+    printf("%lld chaves na Treap\n", contarNos(raiz));
+    printf("uma a uma: %7.1f ns/busca\n", tUmaAUma / n * 1e9);
+    printf("em lote  : %7.1f ns/busca (%.2fx, %s)\n", tLote / n * 1e9, tUmaAUma / tLote,
+           encontradasLote == encontradasUmaAUma ? "mesmos resultados" : "RESULTADOS DIFERENTES");
+    destruirTreap(raiz);
+    free(consultas);
+    free(saida);
+}
+
+// Benchmark da Treap implícita: monta n elementos, faz operacoes inserções/remoções em posições
+// aleatórias e compara com inserir/remover em um vetor (memmove) quando n é pequeno o suficiente
+void benchmarkSequencia(int n, int operacoes) {
+    int* vetor = (int*)malloc((size_t)n * sizeof(int));
+    if (vetor == NULL) {
+        printf("Erro: Falha ao alocar memória para o vetor.\n");
+        exit(-1);
+    }
+    for (int i = 0; i < n; i++)
+        vetor[i] = i;
+
+    double inicio = tempoAtual();
+    NoImplicito* raiz = construirSequencia(vetor, n);
+    printf("Montagem de %d elementos: %.1f ms, altura %d\n", n, (tempoAtual() - inicio) * 1e3, alturaSequencia(raiz));
+
+    uint32_t estado = 12345;
+    inicio = tempoAtual();
+    for (int i = 0; i < operacoes; i++) {
+        estado ^= estado << 13;
+        estado ^= estado >> 17;
+        estado ^= estado << 5;
+        if (i & 1)
+            raiz = removerDaPosicao(raiz, (int)(estado % (uint32_t)tamanho(raiz)));
+        else
+            raiz = inserirNaPosicao(raiz, (int)(estado % (uint32_t)(tamanho(raiz) + 1)), i);
+    }
+    printf("Treap implicita: %8.1f ns por insercao/remocao\n", (tempoAtual() - inicio) / operacoes * 1e9);
+
+    inicio = tempoAtual();
+    for (int i = 0; i < operacoes; i++) {
+        estado ^= estado << 13;
+        estado ^= estado >> 17;
+        estado ^= estado << 5;
+        int a = (int)(estado % (uint32_t)n), b = (int)((estado >> 7) % (uint32_t)n);
+        if (a > b) {
+            int temp = a;
+            a = b;
+            b = temp;
+        }
+        if (i & 1)
+            raiz = inverterIntervalo(raiz, a, b);
+        else
+            raiz = somarIntervalo(raiz, a, b, 1);
+    }
+    printf("Treap implicita: %8.1f ns por inversao/soma em intervalo\n", (tempoAtual() - inicio) / operacoes * 1e9);
+
+    if (n <= 10000000) {
+        // Vetor com espaço para um elemento a mais, já que inserções e remoções se alternam
+        int* maior = (int*)realloc(vetor, ((size_t)n + 1) * sizeof(int));
+        if (maior == NULL) {
+            printf("Erro: Falha ao alocar memória para o vetor.\n");
+            exit(-1);
+        }
+        vetor = maior;
+        int quantidade = n;
+        int operacoesVetor = operacoes < 2000 ? operacoes : 2000;
+        inicio = tempoAtual();
+        for (int i = 0; i < operacoesVetor; i++) {
+            estado ^= estado << 13;
+            estado ^= estado >> 17;
+            estado ^= estado << 5;
+            if (i & 1) {
+                int pos = (int)(estado % (uint32_t)quantidade);
+                memmove(&vetor[pos], &vetor[pos + 1], (size_t)(quantidade - pos - 1) * sizeof(int));
+                quantidade--;
+            } else {
+                int pos = (int)(estado % (uint32_t)(quantidade + 1));
+                memmove(&vetor[pos + 1], &vetor[pos], (size_t)(quantidade - pos) * sizeof(int));
+                vetor[pos] = i;
+                quantidade++;
+            }
+        }
+        printf("Vetor (memmove): %8.1f ns por insercao/remocao\n", (tempoAtual() - inicio) / operacoesVetor * 1e9);
+    }
+    printf("Altura final: %d\n", alturaSequencia(raiz));
+    destruirSequencia(raiz);
+    free(vetor);
 }
 
 // Função principal
-int main() {
+// Uso: AntonioRafael_Treap [bench [n] [threads]]
+//      AntonioRafael_Treap sequencia [n] [operacoes]
+//      AntonioRafael_Treap lote [n]
+int main(int argc, char *argv[]) {
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+        int n = argc > 2 ? atoi(argv[2]) : 1000000;
+        int threads = argc > 3 ? atoi(argv[3]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+        benchmark(n, threads);
+        return 0;
+    }
+    if (argc > 1 && strcmp(argv[1], "lote") == 0) {
+        benchmarkBuscaEmLote(argc > 2 ? atoi(argv[2]) : 4000000);
+        return 0;
+    }
+    if (argc > 1 && strcmp(argv[1], "sequencia") == 0) {
+        int n = argc > 2 ? atoi(argv[2]) : 10000000;
+        int operacoes = argc > 3 ? atoi(argv[3]) : 1000000;
+        benchmarkSequencia(n, operacoes);
+        return 0;
+    }
+
     srand(time(NULL));
     NoTreap* raiz = NULL;
 
@@ -153,8 +799,37 @@ int main() {
     else
         printf("\n%d não encontrado na Treap\n", valorbusc);
 
+    // Operações de conjunto: {40, 60, 70, 80} com {10, 60, 80, 90}
+    NoTreap* outra = NULL;
+    outra = inserir(outra, 10);
+    outra = inserir(outra, 60);
+    outra = inserir(outra, 80);
+    outra = inserir(outra, 90);
+    NoTreap* inter = intersecao(copiarTreap(raiz), copiarTreap(outra), 0);
+    NoTreap* dif = diferenca(copiarTreap(raiz), copiarTreap(outra), 0);
+    raiz = uniao(raiz, outra, 0);
+    printf("\nUniao com {10, 60, 80, 90}: %lld chaves\n", contarNos(raiz));
+    printf("Intersecao: %lld chaves, diferenca: %lld chaves\n", contarNos(inter), contarNos(dif));
+    imprimirTreap(raiz);
+
     // Libera a memória da Treap
     destruirTreap(raiz);
+    destruirTreap(inter);
+    destruirTreap(dif);
+
+    // Treap implícita: sequência 0..9, inverte as posições 2..6 e soma 100 nas posições 0..3
+    int valores[10];
+    for (int i = 0; i < 10; i++)
+        valores[i] = i;
+    NoImplicito* sequencia = construirSequencia(valores, 10);
+    sequencia = inverterIntervalo(sequencia, 2, 6);
+    sequencia = somarIntervalo(sequencia, 0, 3, 100);
+    sequencia = inserirNaPosicao(sequencia, 5, -1);
+    sequencia = removerDaPosicao(sequencia, 0);
+    printf("\nSequencia: ");
+    imprimirSequencia(sequencia);
+    printf("\n");
+    destruirSequencia(sequencia);
 
     return 0;
 }